@@ -1,73 +1,9 @@
-#include "../common/common.h"
-#include <omp.h>
-
-void bubbleSort_parallel(int *array, int size) {
-    bool sorted = false;
-    while (!sorted) {
-        sorted = true;
-
-        // Odd phase
-#pragma omp parallel for
-        for (int i = 1; i < size - 1; i += 2) {
-            if (array[i] > array[i + 1]) {
-                std::swap(array[i], array[i + 1]);
-                sorted = false;
-            }
-        }
-
-        // Even phase
-#pragma omp parallel for
-        for (int i = 0; i < size - 1; i += 2) {
-            if (array[i] > array[i + 1]) {
-                std::swap(array[i], array[i + 1]);
-                sorted = false;
-            }
-        }
-    }
-}
+// bsp.cpp - Parallel Bubble Sort front end (engine: sortlib/bubble.h)
+#include "../common/frontend.h"
+#include "../sort.h"
 
 int main(int argc, char **argv) {
-    int size, seed;
-
-    if (argc == 3) {
-        size = std::stoi(argv[1]);
-        seed = std::stoi(argv[2]);
-    } else {
-        std::cout << "Parallel Bubble Sort" << std::endl;
-        size = getUserInput();
-        std::cout << "Enter seed value for random number generation: ";
-        std::cin >> seed;
-    }
-
-    if (size < 1) {
-        std::cerr << "Size must be at least 1 element." << std::endl;
-        return -1;
-    }
-    if (size > MAX_ELEMENTS) {
-        std::cerr << "Size cannot exceed " << MAX_ELEMENTS << " elements." << std::endl;
-        return -1;
-    }
-
-    int *array = randNumArray(size, seed);
-
-    std::cout << "\nSorting " << size << " elements (random numbers 1-" << MAX_RANDOM_VALUE << ")..." << std::endl;
-    printArray(array, size, "Random Array");
-
-    auto start = std::chrono::high_resolution_clock::now();
-    bubbleSort_parallel(array, size);
-    auto end = std::chrono::high_resolution_clock::now();
-
-    printArray(array, size, "Sorted Array");
-
-    std::chrono::duration<double> duration = end - start;
-    std::cout << "Parallel Bubble Sort Time: " << duration.count() << " seconds" << std::endl;
-
-    if (isSorted(array, size)) {
-        std::cout << "Successfully sorted!" << std::endl;
-    } else {
-        std::cout << "Sorting failed!" << std::endl;
-    }
-
-    delete[] array;
-    return 0;
+    return runSortProgram(argc, argv, "Parallel Bubble Sort", [](int *first, int *last) {
+        sortlib::bubbleSortParallel(first, last);
+    });
 }
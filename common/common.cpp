@@ -1,4 +1,13 @@
 #include "common.h"
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 const int MAX_ELEMENTS = 10000000;
 const int MAX_RANDOM_VALUE = 10000000;
@@ -21,6 +30,30 @@ bool isSorted(const int *array, const int size) {
     return true;
 }
 
+bool shapeArray(int *array, const int size, const std::string &shape, const int seed) {
+    if (shape == "random") {
+        return true;
+    }
+    if (shape == "sorted") {
+        std::sort(array, array + size);
+    } else if (shape == "reversed") {
+        std::sort(array, array + size, std::greater<int>());
+    } else if (shape == "runs") {
+        srand(seed + 1);
+        bool ascending = true;
+        for (int start = 0; start < size;) {
+            int length = std::min(size - start, 1000 + std::rand() % 100000);
+            if (ascending) std::sort(array + start, array + start + length);
+            else std::sort(array + start, array + start + length, std::greater<int>());
+            ascending = !ascending;
+            start += length;
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
 void printArray(const int *array, const int size, const char *label) {
     std::cout << label << " [" << size << " elements]: ";
     if (size <= 10) {
@@ -59,3 +92,49 @@ int getUserInput() {
     }
     return size;
 }
+
+double peakMemoryMB() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0); // bytes on macOS
+#else
+    return usage.ru_maxrss / 1024.0; // kilobytes on Linux
+#endif
+}
+
+const char *mapFile(const char *path, size_t &length) {
+    static const char emptyFile[1] = {0};
+    length = 0;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Cannot open '" << path << "': " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        std::cerr << "Cannot stat '" << path << "': " << std::strerror(errno) << std::endl;
+        close(fd);
+        return nullptr;
+    }
+    if (info.st_size == 0) {
+        close(fd);
+        return emptyFile;
+    }
+    void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        std::cerr << "Cannot map '" << path << "': " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+    length = info.st_size;
+    return static_cast<const char *>(data);
+}
+
+void unmapFile(const char *data, size_t length) {
+    if (data != nullptr && length > 0) {
+        munmap(const_cast<char *>(data), length);
+    }
+}
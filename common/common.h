@@ -5,6 +5,21 @@
 #include <sstream>
 #include <cstdlib>
 #include <chrono>
+#include <string>
+
+// Wall-clock stopwatch; stop() returns the seconds since start().
+class Timer {
+public:
+    void start() { begin = std::chrono::high_resolution_clock::now(); }
+
+    double stop() const {
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - begin;
+        return elapsed.count();
+    }
+
+private:
+    std::chrono::high_resolution_clock::time_point begin;
+};
 
 extern const int MAX_ELEMENTS;
 extern const int MAX_RANDOM_VALUE;
@@ -13,8 +28,22 @@ int *randNumArray(int size, int seed);
 
 bool isSorted(const int *array, int size);
 
+// Rearranges a generated array into a presorted shape: "random" (unchanged),
+// "sorted", "reversed" or "runs" (blocks of random length, alternately
+// ascending and descending). Returns false for an unknown shape.
+bool shapeArray(int *array, int size, const std::string &shape, int seed);
+
 void printArray(const int *array, int size, const char *label);
 
 int getUserInput();
 
+// Peak resident set size of this process so far, in megabytes.
+double peakMemoryMB();
+
+// Maps a whole file read-only into memory. Returns nullptr (and prints the
+// reason) on failure; an empty file maps to a non-null pointer of length 0.
+const char *mapFile(const char *path, size_t &length);
+
+void unmapFile(const char *data, size_t length);
+
 #endif
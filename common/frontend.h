@@ -0,0 +1,114 @@
+#ifndef FRONTEND_H
+#define FRONTEND_H
+
+#include "common.h"
+#include "packed.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Shared main() body of the sort executables:
+//   ./executable [array_size] [random_seed] [output.bp]
+// or interactive input when run without arguments. 'sort' is called once as
+// sort(first, last) on the generated array; passing a lambda keeps the
+// engine call inlined.
+template <typename Sort>
+int runSortProgram(int argc, char **argv, const char *title, Sort sort) {
+    int size, seed;
+    std::string outputPath;
+
+    if (argc == 3 || argc == 4) {
+        // Command line mode; an optional third argument writes the sorted
+        // array to that path in block-packed format
+        size = std::stoi(argv[1]);
+        seed = std::stoi(argv[2]);
+        if (argc == 4) outputPath = argv[3];
+    } else {
+        // Interactive mode
+        std::cout << title << std::endl;
+        size = getUserInput();
+        std::cout << "Enter seed value for random number generation: ";
+        std::cin >> seed;
+    }
+
+    // Validation
+    if (size < 1) {
+        std::cerr << "Size must be at least 1 element." << std::endl;
+        return -1;
+    }
+    if (size > MAX_ELEMENTS) {
+        std::cerr << "Size cannot exceed " << MAX_ELEMENTS << " elements." << std::endl;
+        return -1;
+    }
+
+    int *array = randNumArray(size, seed);
+
+    std::cout << "\nSorting " << size << " elements (random numbers 1-" << MAX_RANDOM_VALUE << ")..." << std::endl;
+    printArray(array, size, "Random Array");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(array, array + size);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    printArray(array, size, "Sorted Array");
+
+    std::chrono::duration<double> duration = end - start;
+    std::cout << title << " Time: " << duration.count() << " seconds" << std::endl;
+    std::cout << "Peak Memory (RSS): " << peakMemoryMB() << " MB" << std::endl;
+
+    if (isSorted(array, size)) {
+        std::cout << "Successfully sorted!" << std::endl;
+    } else {
+        std::cout << "Sorting failed!" << std::endl;
+    }
+
+    if (!outputPath.empty()) {
+        uint64_t bytes = 0;
+        start = std::chrono::high_resolution_clock::now();
+        bool written = writePacked(outputPath.c_str(), array, size, bytes);
+        end = std::chrono::high_resolution_clock::now();
+        if (!written) {
+            delete[] array;
+            return -1;
+        }
+        duration = end - start;
+        std::cout << "Packed Output: " << outputPath << " (" << bytes << " bytes, "
+                  << static_cast<double>(bytes) / size << " bytes/element, "
+                  << static_cast<double>(size) * sizeof(int) / bytes << "x smaller than raw)" << std::endl;
+        std::cout << "Packed Write Time: " << duration.count() << " seconds" << std::endl;
+
+        int readSize = 0;
+        start = std::chrono::high_resolution_clock::now();
+        int *readBack = readPacked(outputPath.c_str(), readSize);
+        end = std::chrono::high_resolution_clock::now();
+        duration = end - start;
+        std::cout << "Packed Read Time: " << duration.count() << " seconds" << std::endl;
+        if (readBack != nullptr && readSize == size && std::equal(array, array + size, readBack)) {
+            std::cout << "Packed output verified!" << std::endl;
+        } else {
+            std::cout << "Packed output verification failed!" << std::endl;
+        }
+        delete[] readBack;
+
+        // Random access: an unaligned range spanning block boundaries
+        int first = size / 3;
+        int count = std::min(size - first, 2 * PACKED_BLOCK_SIZE + 7);
+        std::vector<int> range(count);
+        start = std::chrono::high_resolution_clock::now();
+        bool rangeRead = readPackedRange(outputPath.c_str(), first, count, range.data());
+        end = std::chrono::high_resolution_clock::now();
+        duration = end - start;
+        std::cout << "Packed Range Read Time: " << duration.count() << " seconds (" << count << " elements)"
+                  << std::endl;
+        if (rangeRead && std::equal(range.begin(), range.end(), array + first)) {
+            std::cout << "Packed range [" << first << ", " << first + count << ") verified!" << std::endl;
+        } else {
+            std::cout << "Packed range verification failed!" << std::endl;
+        }
+    }
+
+    delete[] array;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef KEYS_H
+#define KEYS_H
+
+#include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+
+// Key traits for the typed sort engines (int32/int64/uint32/uint64/float/double).
+//
+// Radix engines never compare keys: they sort the unsigned image returned by
+// toRadix(), which preserves the key order bit for bit.
+//   - Unsigned integers are used as they are.
+//   - Signed integers get their sign bit flipped, so negatives come first.
+//   - IEEE floats are sign-magnitude: negatives get every bit flipped and
+//     non-negatives get only the sign bit flipped.
+// NaN placement: every NaN (either sign, any payload) maps to the all-ones
+// image and sorts after +infinity. KeyLess<T> uses the same rule, so radix
+// and comparison engines produce the same order. -0.0 sorts before +0.0 in
+// the radix engines; comparison engines treat them as equal.
+
+template <typename T, typename B>
+struct UnsignedKeyTraits {
+    typedef B Bits;
+    static Bits toRadix(T key) { return static_cast<Bits>(key); }
+    static T random(std::mt19937_64 &rng) { return static_cast<T>(rng()); }
+};
+
+template <typename T, typename B>
+struct SignedKeyTraits {
+    typedef B Bits;
+    static Bits toRadix(T key) {
+        return static_cast<Bits>(key) ^ (static_cast<Bits>(1) << (sizeof(Bits) * 8 - 1));
+    }
+    static T random(std::mt19937_64 &rng) { return static_cast<T>(rng()); }
+};
+
+template <typename T, typename B>
+struct FloatKeyTraits {
+    typedef B Bits;
+    static Bits toRadix(T key) {
+        if (std::isnan(key)) {
+            return ~static_cast<Bits>(0);
+        }
+        Bits bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        const Bits sign = static_cast<Bits>(1) << (sizeof(Bits) * 8 - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+    }
+    // Scores spread over both signs, with the odd special value mixed in so
+    // that NaN/infinity/signed-zero placement is exercised on every run.
+    static T random(std::mt19937_64 &rng) {
+        std::uniform_real_distribution<T> score(-1.0e6, 1.0e6);
+        switch (rng() % 1024) {
+            case 0: return std::numeric_limits<T>::quiet_NaN();
+            case 1: return -std::numeric_limits<T>::quiet_NaN();
+            case 2: return std::numeric_limits<T>::infinity();
+            case 3: return -std::numeric_limits<T>::infinity();
+            case 4: return static_cast<T>(-0.0);
+            default: return score(rng);
+        }
+    }
+};
+
+template <typename T> struct KeyTraits;
+
+template <> struct KeyTraits<int32_t> : SignedKeyTraits<int32_t, uint32_t> {
+    static const char *name() { return "int32"; }
+};
+template <> struct KeyTraits<int64_t> : SignedKeyTraits<int64_t, uint64_t> {
+    static const char *name() { return "int64"; }
+};
+template <> struct KeyTraits<uint32_t> : UnsignedKeyTraits<uint32_t, uint32_t> {
+    static const char *name() { return "uint32"; }
+};
+template <> struct KeyTraits<uint64_t> : UnsignedKeyTraits<uint64_t, uint64_t> {
+    static const char *name() { return "uint64"; }
+};
+template <> struct KeyTraits<float> : FloatKeyTraits<float, uint32_t> {
+    static const char *name() { return "float"; }
+};
+template <> struct KeyTraits<double> : FloatKeyTraits<double, uint64_t> {
+    static const char *name() { return "double"; }
+};
+
+// Strict weak ordering used by the comparison engines. Integers use '<';
+// floats additionally place every NaN after every number.
+template <typename T>
+struct KeyLess {
+    bool operator()(T a, T b) const { return a < b; }
+};
+
+template <typename T>
+struct FloatKeyLess {
+    bool operator()(T a, T b) const { return a < b || (!std::isnan(a) && std::isnan(b)); }
+};
+
+template <> struct KeyLess<float> : FloatKeyLess<float> {};
+template <> struct KeyLess<double> : FloatKeyLess<double> {};
+
+template <typename T>
+T *randKeyArray(const int size, const int seed) {
+    std::mt19937_64 rng(static_cast<uint64_t>(seed));
+    T *array = new T[size];
+    for (int i = 0; i < size; i++) {
+        array[i] = KeyTraits<T>::random(rng);
+    }
+    return array;
+}
+
+template <typename T>
+bool isSortedKeys(const T *array, const int size) {
+    KeyLess<T> less;
+    for (int i = 0; i < size - 1; i++) {
+        if (less(array[i + 1], array[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void printKeys(const T *array, const int size, const char *label) {
+    std::cout << label << " [" << size << " " << KeyTraits<T>::name() << " keys]: ";
+    if (size <= 10) {
+        for (int i = 0; i < size; i++) {
+            std::cout << array[i] << " ";
+        }
+    } else {
+        for (int i = 0; i < 5; i++) {
+            std::cout << array[i] << " ";
+        }
+        std::cout << "... ";
+        for (int i = size - 5; i < size; i++) {
+            std::cout << array[i] << " ";
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Calls fn.template run<T>() for the key type named by 'type'.
+// Returns false if the name is not one of the supported key types.
+template <typename Fn>
+bool dispatchKeyType(const std::string &type, Fn &fn) {
+    if (type == "int32") fn.template run<int32_t>();
+    else if (type == "int64") fn.template run<int64_t>();
+    else if (type == "uint32") fn.template run<uint32_t>();
+    else if (type == "uint64") fn.template run<uint64_t>();
+    else if (type == "float") fn.template run<float>();
+    else if (type == "double") fn.template run<double>();
+    else return false;
+    return true;
+}
+
+const char *const KEY_TYPE_NAMES = "int32|int64|uint32|uint64|float|double";
+
+#endif
@@ -0,0 +1,244 @@
+#include "packed.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Blocks decoded per read while streaming a file back in (about 1-4 MB of payload)
+const int PACKED_READ_BATCH = 1024;
+
+// Widest delta range of int values: max - min < 2^33
+const uint32_t PACKED_MAX_WIDTH = 33;
+// Largest delta magnitude between two int values: 2^32 - 1
+const int64_t PACKED_MAX_DELTA = 0xffffffffLL;
+
+static int blockLength(uint64_t count, uint64_t block) {
+    uint64_t start = block * PACKED_BLOCK_SIZE;
+    return static_cast<int>(count - start < PACKED_BLOCK_SIZE ? count - start : PACKED_BLOCK_SIZE);
+}
+
+static uint64_t payloadBytes(int length, uint32_t width) {
+    return (static_cast<uint64_t>(length - 1) * width + 7) / 8;
+}
+
+static void describeBlock(const int *values, int length, PackedBlock &block) {
+    block.first = values[0];
+    int64_t minDelta = 0, maxDelta = 0;
+    for (int i = 1; i < length; i++) {
+        int64_t delta = static_cast<int64_t>(values[i]) - values[i - 1];
+        if (i == 1 || delta < minDelta) minDelta = delta;
+        if (i == 1 || delta > maxDelta) maxDelta = delta;
+    }
+    uint64_t range = static_cast<uint64_t>(maxDelta - minDelta);
+    uint32_t width = 0;
+    while (width < 64 && (range >> width) != 0) width++;
+    block.minDelta = minDelta;
+    block.width = width;
+}
+
+static void encodeBlock(const int *values, int length, const PackedBlock &block, unsigned char *out) {
+    if (block.width == 0) return;
+    uint64_t buffer = 0;
+    int filled = 0;
+    for (int i = 1; i < length; i++) {
+        uint64_t v = static_cast<uint64_t>(static_cast<int64_t>(values[i]) - values[i - 1] - block.minDelta);
+        buffer |= v << filled;
+        filled += block.width;
+        while (filled >= 8) {
+            *out++ = static_cast<unsigned char>(buffer);
+            buffer >>= 8;
+            filled -= 8;
+        }
+    }
+    if (filled > 0) *out = static_cast<unsigned char>(buffer);
+}
+
+static void decodeBlock(const unsigned char *in, int length, const PackedBlock &block, int *out) {
+    out[0] = block.first;
+    const uint64_t mask = (1ULL << block.width) - 1;
+    uint64_t buffer = 0;
+    int filled = 0;
+    int64_t value = block.first;
+    for (int i = 1; i < length; i++) {
+        while (filled < static_cast<int>(block.width)) {
+            buffer |= static_cast<uint64_t>(*in++) << filled;
+            filled += 8;
+        }
+        value += static_cast<int64_t>(buffer & mask) + block.minDelta;
+        out[i] = static_cast<int>(value);
+        buffer >>= block.width;
+        filled -= block.width;
+    }
+}
+
+bool writePacked(const char *path, const int *array, const int size, uint64_t &bytesWritten) {
+    PackedHeader header;
+    std::memcpy(header.magic, "BPK1", 4);
+    header.blockSize = PACKED_BLOCK_SIZE;
+    header.count = static_cast<uint64_t>(size);
+    header.numBlocks = (header.count + PACKED_BLOCK_SIZE - 1) / PACKED_BLOCK_SIZE;
+    const long long numBlocks = static_cast<long long>(header.numBlocks);
+
+    // Pass 1: per-block frame of reference and bit width
+    std::vector<PackedBlock> index(numBlocks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long long b = 0; b < numBlocks; b++) {
+        describeBlock(array + b * PACKED_BLOCK_SIZE, blockLength(header.count, b), index[b]);
+    }
+
+    // Payload offsets are a prefix sum over the block sizes
+    uint64_t payloadSize = 0;
+    for (long long b = 0; b < numBlocks; b++) {
+        index[b].offset = payloadSize;
+        payloadSize += payloadBytes(blockLength(header.count, b), index[b].width);
+    }
+
+    // Pass 2: every block packs into its own slice of the payload
+    std::vector<unsigned char> payload(payloadSize + 1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long long b = 0; b < numBlocks; b++) {
+        encodeBlock(array + b * PACKED_BLOCK_SIZE, blockLength(header.count, b), index[b],
+                    payload.data() + index[b].offset);
+    }
+
+    FILE *file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        std::cerr << "Cannot open '" << path << "' for writing." << std::endl;
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(index.data(), sizeof(PackedBlock), index.size(), file) == index.size() &&
+              std::fwrite(payload.data(), 1, payloadSize, file) == payloadSize;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::cerr << "Failed writing '" << path << "'." << std::endl;
+        return false;
+    }
+    bytesWritten = sizeof(header) + index.size() * sizeof(PackedBlock) + payloadSize;
+    return true;
+}
+
+static FILE *openPacked(const char *path, PackedHeader &header, std::vector<PackedBlock> &index) {
+    FILE *file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        std::cerr << "Cannot open '" << path << "'." << std::endl;
+        return nullptr;
+    }
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, "BPK1", 4) != 0 ||
+        header.blockSize != PACKED_BLOCK_SIZE || header.count > 0x7fffffffULL ||
+        header.numBlocks != (header.count + PACKED_BLOCK_SIZE - 1) / PACKED_BLOCK_SIZE) {
+        std::cerr << "'" << path << "' is not a block-packed file." << std::endl;
+        std::fclose(file);
+        return nullptr;
+    }
+    index.resize(header.numBlocks);
+    if (std::fread(index.data(), sizeof(PackedBlock), index.size(), file) != index.size()) {
+        std::cerr << "'" << path << "' has a truncated block index." << std::endl;
+        std::fclose(file);
+        return nullptr;
+    }
+
+    // The index comes from another machine: every block must have a valid
+    // width and minDelta, and its payload must end before the next block's
+    // and inside the file
+    long payloadStart = std::ftell(file);
+    if (std::fseek(file, 0, SEEK_END) != 0) {
+        std::cerr << "Cannot seek in '" << path << "'." << std::endl;
+        std::fclose(file);
+        return nullptr;
+    }
+    uint64_t payloadSize = static_cast<uint64_t>(std::ftell(file) - payloadStart);
+    for (size_t b = 0; b < index.size(); b++) {
+        uint64_t end = b + 1 < index.size() ? index[b + 1].offset : payloadSize;
+        if (index[b].width > PACKED_MAX_WIDTH || index[b].minDelta < -PACKED_MAX_DELTA ||
+            index[b].minDelta > PACKED_MAX_DELTA || index[b].offset > end ||
+            payloadBytes(blockLength(header.count, b), index[b].width) > end - index[b].offset) {
+            std::cerr << "'" << path << "' has a corrupt index entry for block " << b << "." << std::endl;
+            std::fclose(file);
+            return nullptr;
+        }
+    }
+    return file;
+}
+
+// Reads blocks [firstBlock, lastBlock) from the payload and decodes them in
+// parallel into out (which corresponds to the first value of firstBlock).
+static bool decodeBlocks(FILE *file, long payloadStart, const PackedHeader &header,
+                         const std::vector<PackedBlock> &index, long long firstBlock, long long lastBlock,
+                         int *out, std::vector<unsigned char> &bytes) {
+    uint64_t begin = index[firstBlock].offset;
+    uint64_t end = lastBlock < static_cast<long long>(index.size()) ? index[lastBlock].offset
+                   : index[lastBlock - 1].offset + payloadBytes(blockLength(header.count, lastBlock - 1),
+                                                                index[lastBlock - 1].width);
+    bytes.resize(end - begin + 8);
+    if (std::fseek(file, payloadStart + static_cast<long>(begin), SEEK_SET) != 0 ||
+        std::fread(bytes.data(), 1, end - begin, file) != end - begin) {
+        return false;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long long b = firstBlock; b < lastBlock; b++) {
+        decodeBlock(bytes.data() + (index[b].offset - begin), blockLength(header.count, b), index[b],
+                    out + (b - firstBlock) * PACKED_BLOCK_SIZE);
+    }
+    return true;
+}
+
+int *readPacked(const char *path, int &size) {
+    PackedHeader header;
+    std::vector<PackedBlock> index;
+    FILE *file = openPacked(path, header, index);
+    if (file == nullptr) return nullptr;
+
+    const long payloadStart = static_cast<long>(sizeof(header) + index.size() * sizeof(PackedBlock));
+    size = static_cast<int>(header.count);
+    int *array = new int[size > 0 ? size : 1];
+    std::vector<unsigned char> bytes;
+    const long long numBlocks = static_cast<long long>(header.numBlocks);
+    for (long long b = 0; b < numBlocks; b += PACKED_READ_BATCH) {
+        long long last = b + PACKED_READ_BATCH < numBlocks ? b + PACKED_READ_BATCH : numBlocks;
+        if (!decodeBlocks(file, payloadStart, header, index, b, last, array + b * PACKED_BLOCK_SIZE, bytes)) {
+            std::cerr << "'" << path << "' has a truncated payload." << std::endl;
+            std::fclose(file);
+            delete[] array;
+            return nullptr;
+        }
+    }
+    std::fclose(file);
+    return array;
+}
+
+bool readPackedRange(const char *path, const int first, const int count, int *out) {
+    PackedHeader header;
+    std::vector<PackedBlock> index;
+    FILE *file = openPacked(path, header, index);
+    if (file == nullptr) return false;
+    if (first < 0 || count < 0 || static_cast<uint64_t>(first) + count > header.count) {
+        std::cerr << "Range [" << first << ", " << first + count << ") is outside '" << path << "'." << std::endl;
+        std::fclose(file);
+        return false;
+    }
+    if (count == 0) {
+        std::fclose(file);
+        return true;
+    }
+
+    const long payloadStart = static_cast<long>(sizeof(header) + index.size() * sizeof(PackedBlock));
+    long long firstBlock = first / PACKED_BLOCK_SIZE;
+    long long lastBlock = (static_cast<long long>(first) + count - 1) / PACKED_BLOCK_SIZE + 1;
+    std::vector<int> decoded((lastBlock - firstBlock) * PACKED_BLOCK_SIZE);
+    std::vector<unsigned char> bytes;
+    bool ok = decodeBlocks(file, payloadStart, header, index, firstBlock, lastBlock, decoded.data(), bytes);
+    std::fclose(file);
+    if (!ok) {
+        std::cerr << "'" << path << "' has a truncated payload." << std::endl;
+        return false;
+    }
+    std::memcpy(out, decoded.data() + (first - firstBlock * PACKED_BLOCK_SIZE), count * sizeof(int));
+    return true;
+}
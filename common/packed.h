@@ -0,0 +1,51 @@
+#ifndef PACKED_H
+#define PACKED_H
+
+#include <cstdint>
+
+// Block-packed ("BPK1") format for int arrays, aimed at sorted output.
+//
+// The array is cut into blocks of PACKED_BLOCK_SIZE values. Each block keeps
+// its first value and packs the deltas between neighbours with frame of
+// reference: every delta is stored as (delta - minDelta) in 'width' bits.
+// Sorted arrays have small non-negative deltas, so a block of 1..10,000,000
+// keys typically needs a handful of bits per value instead of 32. Unsorted
+// input still round-trips, just with wider blocks.
+//
+// File layout (native little-endian):
+//   PackedHeader
+//   PackedBlock index[numBlocks]      first value, minDelta, width, payload offset
+//   payload bytes                     packed deltas, block after block
+// Every block decodes on its own, so blocks are encoded and decoded in
+// parallel and any range can be read back through the index.
+
+const int PACKED_BLOCK_SIZE = 1024;
+
+struct PackedHeader {
+    char magic[4];
+    uint32_t blockSize;
+    uint64_t count;
+    uint64_t numBlocks;
+};
+
+struct PackedBlock {
+    int64_t minDelta;
+    int32_t first;
+    uint32_t width;
+    uint64_t offset; // payload offset of this block, relative to the payload start
+};
+
+// Encodes and writes 'array'; bytesWritten receives the file size. Returns
+// false (and prints the reason) on I/O error.
+bool writePacked(const char *path, const int *array, int size, uint64_t &bytesWritten);
+
+// Reads a whole packed file back into a new[]-allocated array, streaming the
+// payload in batches of blocks. Returns nullptr on error, including an index
+// with a width above 33 bits or payload offsets that overlap or run past
+// the end of the file.
+int *readPacked(const char *path, int &size);
+
+// Decodes only the blocks covering [first, first + count) into 'out'.
+bool readPackedRange(const char *path, int first, int count, int *out);
+
+#endif
@@ -0,0 +1,100 @@
+#include "common/common.h"
+#include "common/keys.h"
+#include "sort.h"
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+// Benchmarks every key type against every typed engine: the two radix
+// engines and the comparison engines of sort.h instantiated with KeyLess<T>,
+// so each key type gets its own inlined comparator instead of an indirect call.
+
+template <typename T>
+void quickSortKeysParallel(T *array, int size) {
+    sortlib::quickSortParallel(array, array + size, KeyLess<T>());
+}
+
+template <typename T>
+void mergeSortKeysParallel(T *array, int size) {
+    sortlib::mergeSortParallel(array, array + size, KeyLess<T>());
+}
+
+template <typename T>
+void stdSortKeys(T *array, int size) {
+    sortlib::stlSort(array, array + size, KeyLess<T>());
+}
+
+struct KeyBenchRun {
+    int size, seed;
+
+    template <typename T>
+    void run() {
+        typedef void (*KeySortFunction)(T *, int);
+        struct Engine {
+            const char *name;
+            KeySortFunction function;
+        };
+        const Engine engines[] = {
+            {"radix serial", sortlib::radixSortSerial<T>},
+            {"radix parallel", sortlib::radixSortParallel<T>},
+            {"quick parallel", quickSortKeysParallel<T>},
+            {"merge parallel", mergeSortKeysParallel<T>},
+            {"std::sort", stdSortKeys<T>}
+        };
+
+        T *original = randKeyArray<T>(size, seed);
+        T *array = new T[size];
+        for (const Engine &engine : engines) {
+            std::copy(original, original + size, array);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            engine.function(array, size);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::chrono::duration<double> duration = end - start;
+            std::cout << std::left << std::setw(8) << KeyTraits<T>::name()
+                      << std::setw(16) << engine.name
+                      << std::setw(14) << duration.count()
+                      << (isSortedKeys(array, size) ? "ok" : "FAILED") << std::endl;
+        }
+        delete[] array;
+        delete[] original;
+    }
+};
+
+int main(int argc, char **argv) {
+    int size, seed;
+
+    if (argc == 3) {
+        // Command line mode
+        size = std::stoi(argv[1]);
+        seed = std::stoi(argv[2]);
+    } else {
+        // Interactive mode
+        std::cout << "Typed Key Benchmark" << std::endl;
+        size = getUserInput();
+        std::cout << "Enter seed value for random number generation: ";
+        std::cin >> seed;
+    }
+
+    // Validation
+    if (size < 1) {
+        std::cerr << "Size must be at least 1 element." << std::endl;
+        return -1;
+    }
+    if (size > MAX_ELEMENTS) {
+        std::cerr << "Size cannot exceed " << MAX_ELEMENTS << " elements." << std::endl;
+        return -1;
+    }
+
+    std::cout << "\nSorting " << size << " keys of each type (" << KEY_TYPE_NAMES << ")..." << std::endl;
+    std::cout << std::left << std::setw(8) << "Type" << std::setw(16) << "Algorithm"
+              << std::setw(14) << "Seconds" << "Result" << std::endl;
+
+    KeyBenchRun benchRun = {size, seed};
+    const char *types[] = {"int32", "int64", "uint32", "uint64", "float", "double"};
+    for (const char *type : types) {
+        dispatchKeyType(type, benchRun);
+    }
+    return 0;
+}
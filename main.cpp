@@ -1,5 +1,6 @@
 #include <iostream>
 #include <sstream>
+#include <cmath>
 #include <cstdlib>
 #include <string>
 #include "common/common.h"
@@ -12,9 +13,13 @@ void runQuickSortSerial(int* array, int size);
 void runQuickSortParallel(int* array, int size);
 void runMergeSortSerial(int* array, int size);
 void runMergeSortParallel(int* array, int size);
+void runLeanMergeSortParallel(int* array, int size);
+void runNaturalMergeSortParallel(int* array, int size);
+void runMultiwayMergeSortParallel(int* array, int size);
 void runReferenceSort(int* array, int size);
 
-// Function pointer type for sorting functions
+// Function pointer type for the wrappers below. Only the dispatch goes
+// through the pointer; each wrapper calls a template engine from sort.h.
 typedef void (*SortFunction)(int*, int);
 
 // Structure to map executable names to sorting functions
@@ -32,6 +37,9 @@ SortAlgorithm algorithms[] = {
     {"qsp", runQuickSortParallel, "Quick Sort Parallel"},
     {"mss", runMergeSortSerial, "Merge Sort Serial"},
     {"msp", runMergeSortParallel, "Merge Sort Parallel"},
+    {"mlp", runLeanMergeSortParallel, "Memory-Lean Merge Sort Parallel (sqrt(n) auxiliary)"},
+    {"nmp", runNaturalMergeSortParallel, "Natural Merge Sort Parallel"},
+    {"mwp", runMultiwayMergeSortParallel, "Multiway Merge Sort Parallel"},
     {"reference", runReferenceSort, "STL Reference Sort"}
 };
 
@@ -115,11 +123,9 @@ int main(int argc, char** argv) {
 
     // Display first few elements (for verification)
     if (size <= 20) {
-        std::cout << "Original Array: ";
-        printArray(array, size);
+        printArray(array, size, "Original Array");
     } else {
-        std::cout << "First 10 elements of original array: ";
-        printArray(array, 10);
+        printArray(array, 10, "First 10 elements of original array");
     }
 
     // Execute the selected sorting algorithm
@@ -140,11 +146,9 @@ int main(int argc, char** argv) {
 
     // Display first few elements of sorted array
     if (size <= 20) {
-        std::cout << "Sorted Array: ";
-        printArray(array, size);
+        printArray(array, size, "Sorted Array");
     } else {
-        std::cout << "First 10 elements of sorted array: ";
-        printArray(array, 10);
+        printArray(array, 10, "First 10 elements of sorted array");
     }
 
     // Clean up
@@ -157,7 +161,7 @@ int main(int argc, char** argv) {
 void runBubbleSortSerial(int* array, int size) {
     Timer timer;
     timer.start();
-    bubbleSortSerial(array, size);
+    sortlib::bubbleSortSerial(array, array + size);
     double elapsed = timer.stop();
     std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
 }
@@ -165,7 +169,7 @@ void runBubbleSortSerial(int* array, int size) {
 void runBubbleSortParallel(int* array, int size) {
     Timer timer;
     timer.start();
-    bubbleSortParallel(array, size);
+    sortlib::bubbleSortParallel(array, array + size);
     double elapsed = timer.stop();
     std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
 }
@@ -173,7 +177,7 @@ void runBubbleSortParallel(int* array, int size) {
 void runQuickSortSerial(int* array, int size) {
     Timer timer;
     timer.start();
-    quickSortSerial(array, size);
+    sortlib::quickSortSerial(array, array + size);
     double elapsed = timer.stop();
     std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
 }
@@ -181,7 +185,7 @@ void runQuickSortSerial(int* array, int size) {
 void runQuickSortParallel(int* array, int size) {
     Timer timer;
     timer.start();
-    quickSortParallel(array, size);
+    sortlib::quickSortParallel(array, array + size);
     double elapsed = timer.stop();
     std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
 }
@@ -189,7 +193,7 @@ void runQuickSortParallel(int* array, int size) {
 void runMergeSortSerial(int* array, int size) {
     Timer timer;
     timer.start();
-    mergeSortSerial(array, size);
+    sortlib::mergeSortSerial(array, array + size);
     double elapsed = timer.stop();
     std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
 }
@@ -197,7 +201,31 @@ void runMergeSortSerial(int* array, int size) {
 void runMergeSortParallel(int* array, int size) {
     Timer timer;
     timer.start();
-    mergeSortParallel(array, size);
+    sortlib::mergeSortParallel(array, array + size);
+    double elapsed = timer.stop();
+    std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
+}
+
+void runLeanMergeSortParallel(int* array, int size) {
+    Timer timer;
+    timer.start();
+    sortlib::leanMergeSortParallel(array, array + size, static_cast<long long>(std::sqrt(static_cast<double>(size))));
+    double elapsed = timer.stop();
+    std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
+}
+
+void runNaturalMergeSortParallel(int* array, int size) {
+    Timer timer;
+    timer.start();
+    sortlib::naturalMergeSortParallel(array, array + size);
+    double elapsed = timer.stop();
+    std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
+}
+
+void runMultiwayMergeSortParallel(int* array, int size) {
+    Timer timer;
+    timer.start();
+    sortlib::multiwayMergeSortParallel(array, array + size);
     double elapsed = timer.stop();
     std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
 }
@@ -205,7 +233,7 @@ void runMergeSortParallel(int* array, int size) {
 void runReferenceSort(int* array, int size) {
     Timer timer;
     timer.start();
-    referenceSort(array, size);
+    sortlib::stlSort(array, array + size);
     double elapsed = timer.stop();
     std::cout << "Execution Time: " << elapsed << " seconds" << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+// mlp.cpp - Memory-Lean Parallel Merge Sort front end (engine: sortlib/lean.h)
+#include "../common/common.h"
+#include "../sort.h"
+#include <omp.h>
+#include <cmath>
+#include <string>
+
+// Parses the auxiliary budget: "sqrt" (sqrt(n) elements), "<N>MB" or a plain
+// element count. Returns -1 if the text is not a valid budget.
+long long parseBudget(const std::string &text, int size) {
+    try {
+        if (text == "sqrt") {
+            return static_cast<long long>(std::sqrt(static_cast<double>(size)));
+        }
+        if (text.size() > 2 && (text.compare(text.size() - 2, 2, "MB") == 0 ||
+                                text.compare(text.size() - 2, 2, "mb") == 0)) {
+            return std::stoll(text.substr(0, text.size() - 2)) * 1024 * 1024 / sizeof(int);
+        }
+        return std::stoll(text);
+    } catch (const std::exception &) {
+        return -1;
+    }
+}
+
+int main(int argc, char **argv) {
+    int size, seed;
+    std::string budgetText = "sqrt";
+
+    if (argc == 3 || argc == 4) {
+        // Command line mode
+        size = std::stoi(argv[1]);
+        seed = std::stoi(argv[2]);
+        if (argc == 4) budgetText = argv[3];
+    } else {
+        // Interactive mode
+        std::cout << "Memory-Lean Parallel Merge Sort" << std::endl;
+        size = getUserInput();
+        std::cout << "Enter seed value for random number generation: ";
+        std::cin >> seed;
+        std::cout << "Enter auxiliary budget (sqrt, <N>MB or element count): ";
+        std::cin >> budgetText;
+    }
+
+    // Validation
+    if (size < 1) {
+        std::cerr << "Size must be at least 1 element." << std::endl;
+        return -1;
+    }
+    if (size > MAX_ELEMENTS) {
+        std::cerr << "Size cannot exceed " << MAX_ELEMENTS << " elements." << std::endl;
+        return -1;
+    }
+    long long budget = parseBudget(budgetText, size);
+    if (budget < 1) {
+        std::cerr << "Invalid auxiliary budget '" << budgetText << "' (expected sqrt, <N>MB or element count)." << std::endl;
+        return -1;
+    }
+
+    // The engine splits the budget evenly over the threads
+    int threads = omp_get_max_threads();
+    long long bufferSize = sortlib::leanBufferSize(size, budget, threads);
+
+    int *array = randNumArray(size, seed);
+
+    std::cout << "\nSorting " << size << " elements (random numbers 1-" << MAX_RANDOM_VALUE << ")..." << std::endl;
+    std::cout << "Auxiliary Budget: " << bufferSize * threads << " elements ("
+              << threads << " x " << bufferSize << ", "
+              << static_cast<double>(bufferSize) * threads * sizeof(int) / (1024.0 * 1024.0) << " MB)" << std::endl;
+    printArray(array, size, "Random Array");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    sortlib::leanMergeSortParallel(array, array + size, budget);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    printArray(array, size, "Sorted Array");
+
+    std::chrono::duration<double> duration = end - start;
+    std::cout << "Memory-Lean Parallel Merge Sort Time: " << duration.count() << " seconds" << std::endl;
+    std::cout << "Peak Memory (RSS): " << peakMemoryMB() << " MB" << std::endl;
+
+    if (isSorted(array, size)) {
+        std::cout << "Successfully sorted!" << std::endl;
+    } else {
+        std::cout << "Sorting failed!" << std::endl;
+    }
+
+    delete[] array;
+    return 0;
+}
@@ -0,0 +1,9 @@
+// mwp.cpp - Parallel Cache-Aware Multiway Merge Sort front end (engine: sortlib/multiway.h)
+#include "../common/frontend.h"
+#include "../sort.h"
+
+int main(int argc, char **argv) {
+    return runSortProgram(argc, argv, "Parallel Multiway Merge Sort", [](int *first, int *last) {
+        sortlib::multiwayMergeSortParallel(first, last);
+    });
+}
@@ -0,0 +1,64 @@
+// nmp.cpp - Natural Parallel Merge Sort front end (engine: sortlib/natural.h)
+#include "../common/common.h"
+#include "../sort.h"
+#include <string>
+
+int main(int argc, char **argv) {
+    int size, seed;
+    std::string shape = "random";
+
+    if (argc == 3 || argc == 4) {
+        // Command line mode
+        size = std::stoi(argv[1]);
+        seed = std::stoi(argv[2]);
+        if (argc == 4) shape = argv[3];
+    } else {
+        // Interactive mode
+        std::cout << "Natural Parallel Merge Sort" << std::endl;
+        size = getUserInput();
+        std::cout << "Enter seed value for random number generation: ";
+        std::cin >> seed;
+        std::cout << "Enter input shape (random, sorted, reversed, runs): ";
+        std::cin >> shape;
+    }
+
+    // Validation
+    if (size < 1) {
+        std::cerr << "Size must be at least 1 element." << std::endl;
+        return -1;
+    }
+    if (size > MAX_ELEMENTS) {
+        std::cerr << "Size cannot exceed " << MAX_ELEMENTS << " elements." << std::endl;
+        return -1;
+    }
+
+    int *array = randNumArray(size, seed);
+    if (!shapeArray(array, size, shape, seed)) {
+        std::cerr << "Unknown input shape '" << shape << "' (expected random, sorted, reversed or runs)." << std::endl;
+        delete[] array;
+        return -1;
+    }
+
+    std::cout << "\nSorting " << size << " elements (random numbers 1-" << MAX_RANDOM_VALUE << ", "
+              << shape << " input)..." << std::endl;
+    printArray(array, size, "Input Array");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    sortlib::naturalMergeSortParallel(array, array + size);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    printArray(array, size, "Sorted Array");
+
+    std::chrono::duration<double> duration = end - start;
+    std::cout << "Natural Parallel Merge Sort Time: " << duration.count() << " seconds" << std::endl;
+    std::cout << "Peak Memory (RSS): " << peakMemoryMB() << " MB" << std::endl;
+
+    if (isSorted(array, size)) {
+        std::cout << "Successfully sorted!" << std::endl;
+    } else {
+        std::cout << "Sorting failed!" << std::endl;
+    }
+
+    delete[] array;
+    return 0;
+}
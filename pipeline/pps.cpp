@@ -0,0 +1,340 @@
+#include "../common/common.h"
+#include <omp.h>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Pipelined parallel sort: input, sorting and merging overlap.
+//
+// One thread produces the input chunk by chunk (generating it exactly like
+// randNumArray, or reading integers from a text file). Every finished chunk
+// becomes a sort task right away, while the producer moves on to the next
+// chunk. Sorted segments are merged like a binary counter: whenever the two
+// newest segments have the same level, a merge task combines them as soon as
+// both are ready (OpenMP task dependences). When the input ends, the few
+// remaining segments are merged in one streaming pass that verifies the
+// order and writes the output as it goes, so the total time approaches
+// max(input, sort) instead of their sum.
+
+const int DEFAULT_CHUNK = 1 << 18;
+
+struct Segment {
+    int *data;
+    int length;
+};
+
+// Buffered reader for whitespace-separated integers.
+class IntReader {
+public:
+    explicit IntReader(FILE *file) : file(file), pos(0), end(0), outOfRange(false) {}
+
+    // Reads the next integer. A '-' without digits is skipped. Returns false
+    // at the end of the input, or at a value outside int (failed() is true).
+    bool next(int &value) {
+        while (true) {
+            int c = peek();
+            while (c != EOF && c != '-' && (c < '0' || c > '9')) {
+                pos++;
+                c = peek();
+            }
+            if (c == EOF) return false;
+            bool negative = c == '-';
+            if (negative) {
+                pos++;
+                c = peek();
+                if (c < '0' || c > '9') continue;
+            }
+            // Largest magnitude that fits: 2^31 - 1, or 2^31 when negative
+            const long long limit = negative ? -static_cast<long long>(INT_MIN) : INT_MAX;
+            long long number = 0;
+            while (c >= '0' && c <= '9') {
+                number = number * 10 + (c - '0');
+                if (number > limit) {
+                    outOfRange = true;
+                    return false;
+                }
+                pos++;
+                c = peek();
+            }
+            value = static_cast<int>(negative ? -number : number);
+            return true;
+        }
+    }
+
+    bool failed() const { return outOfRange; }
+
+private:
+    int peek() {
+        if (pos == end) {
+            end = std::fread(buffer, 1, sizeof(buffer), file);
+            pos = 0;
+            if (end == 0) return EOF;
+        }
+        return static_cast<unsigned char>(buffer[pos]);
+    }
+
+    FILE *file;
+    char buffer[1 << 20];
+    size_t pos, end;
+    bool outOfRange;
+};
+
+// Buffered writer for one integer per line.
+class IntWriter {
+public:
+    explicit IntWriter(FILE *file) : file(file), used(0), ok(true) {}
+    ~IntWriter() { flush(); }
+
+    void write(int value) {
+        if (used > sizeof(buffer) - 16) flush();
+        used += snprintf(buffer + used, 16, "%d\n", value);
+    }
+
+    // Returns false once any write has failed.
+    bool flush() {
+        if (file != nullptr && used > 0 && std::fwrite(buffer, 1, used, file) != used) ok = false;
+        used = 0;
+        return ok;
+    }
+
+private:
+    FILE *file;
+    char buffer[1 << 20];
+    size_t used;
+    bool ok;
+};
+
+void mergeSegments(Segment *left, Segment *right) {
+    int *merged = new int[left->length + right->length];
+    std::merge(left->data, left->data + left->length, right->data, right->data + right->length, merged);
+    delete[] left->data;
+    delete[] right->data;
+    left->data = merged;
+    left->length += right->length;
+    right->data = nullptr;
+    right->length = 0;
+}
+
+// Produces the input chunk by chunk, handing each chunk to a sort task and
+// merging equal-level segments as they complete. Returns the segments left
+// once the input is exhausted (oldest first) after all tasks have finished.
+template <typename Producer>
+std::vector<Segment *> sortPipelined(Producer &produce, int chunkSize, std::deque<Segment> &segments,
+                                     double &inputSeconds) {
+    std::vector<std::pair<Segment *, int> > stack; // segment and its merge level
+    double inputTime = 0.0;
+
+#pragma omp parallel
+    {
+#pragma omp single
+        {
+            while (true) {
+                double begin = omp_get_wtime();
+                int *chunk = new int[chunkSize];
+                int length = produce(chunk, chunkSize);
+                inputTime += omp_get_wtime() - begin;
+                if (length == 0) {
+                    delete[] chunk;
+                    break;
+                }
+
+                segments.push_back(Segment());
+                Segment *segment = &segments.back();
+                segment->data = chunk;
+                segment->length = length;
+#pragma omp task firstprivate(segment) depend(out: segment[0])
+                std::sort(segment->data, segment->data + segment->length);
+
+                stack.push_back(std::make_pair(segment, 0));
+                while (stack.size() >= 2 && stack[stack.size() - 2].second == stack.back().second) {
+                    Segment *right = stack.back().first;
+                    stack.pop_back();
+                    Segment *left = stack.back().first;
+                    stack.back().second++;
+#pragma omp task firstprivate(left, right) depend(inout: left[0]) depend(inout: right[0])
+                    mergeSegments(left, right);
+                }
+                if (length < chunkSize) break;
+            }
+#pragma omp taskwait
+        }
+    }
+
+    inputSeconds = inputTime;
+    std::vector<Segment *> remaining;
+    for (size_t i = 0; i < stack.size(); i++) remaining.push_back(stack[i].first);
+    return remaining;
+}
+
+// Streams the final k-way merge: verifies the order, writes the output (if
+// any) and prints the first and last five values like printArray. 'written'
+// is false if writing the output failed.
+bool streamFinalMerge(const std::vector<Segment *> &segments, long long total, FILE *output, bool &written) {
+    typedef std::pair<int, int> Head; // value, segment
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head> > heads;
+    std::vector<int> position(segments.size(), 0);
+    for (size_t s = 0; s < segments.size(); s++) {
+        if (segments[s]->length > 0) heads.push(Head(segments[s]->data[0], static_cast<int>(s)));
+    }
+
+    IntWriter writer(output);
+    bool sorted = true;
+    long long index = 0;
+    int previous = 0;
+    std::vector<int> tail;
+    std::cout << "Sorted Array [" << total << " elements]: ";
+    while (!heads.empty()) {
+        Head head = heads.top();
+        heads.pop();
+        int value = head.first;
+        if (index > 0 && value < previous) sorted = false;
+        if (output != nullptr) writer.write(value);
+        if (index < 5 || total <= 10) std::cout << value << " ";
+        else if (index >= total - 5) tail.push_back(value);
+        previous = value;
+        index++;
+
+        int s = head.second;
+        if (++position[s] < segments[s]->length) {
+            heads.push(Head(segments[s]->data[position[s]], s));
+        }
+    }
+    if (total > 10) {
+        std::cout << "... ";
+        for (size_t i = 0; i < tail.size(); i++) std::cout << tail[i] << " ";
+    }
+    std::cout << std::endl;
+    written = writer.flush();
+    return sorted && index == total;
+}
+
+int main(int argc, char **argv) {
+    int size = 0, seed = 0, chunkSize = DEFAULT_CHUNK;
+    std::string inputPath, outputPath;
+
+    if (argc >= 3 && std::string(argv[1]) == "--file") {
+        // File mode: whitespace-separated integers, read while earlier chunks sort
+        inputPath = argv[2];
+        if (argc >= 4) chunkSize = std::stoi(argv[3]);
+        if (argc >= 5) outputPath = argv[4];
+    } else if (argc >= 3) {
+        // Command line mode
+        size = std::stoi(argv[1]);
+        seed = std::stoi(argv[2]);
+        if (argc >= 4) chunkSize = std::stoi(argv[3]);
+        if (argc >= 5) outputPath = argv[4];
+    } else {
+        // Interactive mode
+        std::cout << "Pipelined Parallel Sort" << std::endl;
+        size = getUserInput();
+        std::cout << "Enter seed value for random number generation: ";
+        std::cin >> seed;
+    }
+
+    // Validation
+    if (inputPath.empty() && size < 1) {
+        std::cerr << "Size must be at least 1 element." << std::endl;
+        return -1;
+    }
+    if (inputPath.empty() && size > MAX_ELEMENTS) {
+        std::cerr << "Size cannot exceed " << MAX_ELEMENTS << " elements." << std::endl;
+        return -1;
+    }
+    if (chunkSize < 1) {
+        std::cerr << "Chunk size must be at least 1 element." << std::endl;
+        return -1;
+    }
+
+    FILE *input = nullptr;
+    if (!inputPath.empty()) {
+        input = std::fopen(inputPath.c_str(), "rb");
+        if (input == nullptr) {
+            std::cerr << "Cannot open '" << inputPath << "'." << std::endl;
+            return -1;
+        }
+    }
+    FILE *output = nullptr;
+    if (!outputPath.empty()) {
+        output = std::fopen(outputPath.c_str(), "wb");
+        if (output == nullptr) {
+            std::cerr << "Cannot open '" << outputPath << "' for writing." << std::endl;
+            if (input != nullptr) std::fclose(input);
+            return -1;
+        }
+    }
+
+    if (input == nullptr) {
+        std::cout << "\nSorting " << size << " elements (random numbers 1-" << MAX_RANDOM_VALUE << ") in chunks of "
+                  << chunkSize << "..." << std::endl;
+    } else {
+        std::cout << "\nSorting integers from " << inputPath << " in chunks of " << chunkSize << "..." << std::endl;
+    }
+
+    // Same sequence as randNumArray(size, seed), produced one chunk at a time
+    srand(seed);
+    int generated = 0;
+    IntReader *reader = input != nullptr ? new IntReader(input) : nullptr;
+    auto produce = [&](int *chunk, int capacity) {
+        int length = 0;
+        if (reader != nullptr) {
+            while (length < capacity && reader->next(chunk[length])) length++;
+        } else {
+            length = std::min(capacity, size - generated);
+            for (int i = 0; i < length; i++) {
+                chunk[i] = (std::rand() % MAX_RANDOM_VALUE) + 1;
+            }
+            generated += length;
+        }
+        return length;
+    };
+
+    std::deque<Segment> segments;
+    double inputSeconds = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<Segment *> remaining = sortPipelined(produce, chunkSize, segments, inputSeconds);
+    auto sorted = std::chrono::high_resolution_clock::now();
+    if (reader != nullptr && reader->failed()) {
+        std::cerr << "'" << inputPath << "' holds a value outside the int range (" << INT_MIN << " to " << INT_MAX
+                  << ")." << std::endl;
+        for (size_t i = 0; i < segments.size(); i++) delete[] segments[i].data;
+        delete reader;
+        std::fclose(input);
+        if (output != nullptr) std::fclose(output);
+        return -1;
+    }
+
+    long long total = 0;
+    for (size_t i = 0; i < remaining.size(); i++) total += remaining[i]->length;
+    bool written = true;
+    bool ok = streamFinalMerge(remaining, total, output, written);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration<double> sortDuration = sorted - start;
+    std::chrono::duration<double> duration = end - start;
+    std::cout << "Input Time (overlapped): " << inputSeconds << " seconds" << std::endl;
+    std::cout << "Chunks: " << segments.size() << ", segments in final merge: " << remaining.size() << std::endl;
+    std::cout << "Input + Sort Time: " << sortDuration.count() << " seconds" << std::endl;
+    std::cout << "Pipelined Sort Time: " << duration.count() << " seconds" << std::endl;
+
+    if (ok) {
+        std::cout << "Successfully sorted!" << std::endl;
+    } else {
+        std::cout << "Sorting failed!" << std::endl;
+    }
+
+    for (size_t i = 0; i < segments.size(); i++) delete[] segments[i].data;
+    delete reader;
+    if (input != nullptr) std::fclose(input);
+    if (output != nullptr) written = (std::fclose(output) == 0) && written;
+    if (!written) {
+        std::cerr << "Failed writing '" << outputPath << "'." << std::endl;
+        return -1;
+    }
+    return 0;
+}
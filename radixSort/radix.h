@@ -0,0 +1,137 @@
+#ifndef RADIX_H
+#define RADIX_H
+
+#include "../common/keys.h"
+#include <algorithm>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// LSD radix sort over the order-preserving image KeyTraits<T>::toRadix(),
+// one 8-bit digit per pass (4 passes for 32-bit keys, 8 for 64-bit keys).
+// A pass is skipped when every key has the same digit, which is common for
+// the high bytes of IDs and timestamps.
+
+namespace sortlib {
+
+namespace detail {
+
+const int RADIX_BITS = 8;
+const int RADIX_BUCKETS = 1 << RADIX_BITS;
+
+template <typename T>
+inline int radixDigit(const T key, const int pass) {
+    return static_cast<int>((KeyTraits<T>::toRadix(key) >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1));
+}
+
+} // namespace detail
+
+template <typename T>
+void radixSortSerial(T *array, int size) {
+    const int passes = sizeof(typename KeyTraits<T>::Bits);
+    T *buffer = new T[size];
+    T *src = array, *dst = buffer;
+    int count[detail::RADIX_BUCKETS];
+
+    for (int pass = 0; pass < passes; pass++) {
+        std::fill(count, count + detail::RADIX_BUCKETS, 0);
+        for (int i = 0; i < size; i++) {
+            count[detail::radixDigit(src[i], pass)]++;
+        }
+        if (*std::max_element(count, count + detail::RADIX_BUCKETS) == size) {
+            continue;
+        }
+
+        int offset = 0;
+        for (int d = 0; d < detail::RADIX_BUCKETS; d++) {
+            int c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (int i = 0; i < size; i++) {
+            dst[count[detail::radixDigit(src[i], pass)]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != array) {
+        std::copy(src, src + size, array);
+    }
+    delete[] buffer;
+}
+
+#ifdef _OPENMP
+// Each thread owns a contiguous chunk. Per pass: every thread builds the
+// histogram of its chunk, one thread turns the histograms into scatter
+// offsets (digit-major, thread-minor, which keeps the sort stable), and
+// every thread scatters its chunk.
+template <typename T>
+void radixSortParallel(T *array, int size) {
+    const int passes = sizeof(typename KeyTraits<T>::Bits);
+    T *buffer = new T[size];
+    const int maxThreads = omp_get_max_threads();
+    std::vector<int> counts(maxThreads * detail::RADIX_BUCKETS);
+    int numThreads = 1;
+    bool skip = false;
+    T *result = array;
+
+#pragma omp parallel
+    {
+        const int tid = omp_get_thread_num();
+#pragma omp single
+        numThreads = omp_get_num_threads();
+        const int lo = static_cast<int>(static_cast<long long>(size) * tid / numThreads);
+        const int hi = static_cast<int>(static_cast<long long>(size) * (tid + 1) / numThreads);
+        int *count = &counts[tid * detail::RADIX_BUCKETS];
+        T *src = array, *dst = buffer;
+
+        for (int pass = 0; pass < passes; pass++) {
+            std::fill(count, count + detail::RADIX_BUCKETS, 0);
+            for (int i = lo; i < hi; i++) {
+                count[detail::radixDigit(src[i], pass)]++;
+            }
+#pragma omp barrier
+#pragma omp single
+            {
+                skip = false;
+                int offset = 0;
+                for (int d = 0; d < detail::RADIX_BUCKETS && !skip; d++) {
+                    int start = offset;
+                    for (int t = 0; t < numThreads; t++) {
+                        int c = counts[t * detail::RADIX_BUCKETS + d];
+                        counts[t * detail::RADIX_BUCKETS + d] = offset;
+                        offset += c;
+                    }
+                    skip = (offset - start == size);
+                }
+            }
+            if (skip) {
+                continue;
+            }
+            for (int i = lo; i < hi; i++) {
+                dst[count[detail::radixDigit(src[i], pass)]++] = src[i];
+            }
+#pragma omp barrier
+            std::swap(src, dst);
+        }
+
+#pragma omp single
+        result = src;
+        if (result != array) {
+            std::copy(result + lo, result + hi, array + lo);
+        }
+    }
+    delete[] buffer;
+}
+#else
+// Without OpenMP the parallel engine falls back to the serial one.
+template <typename T>
+void radixSortParallel(T *array, int size) {
+    radixSortSerial(array, size);
+}
+#endif
+
+} // namespace sortlib
+
+#endif
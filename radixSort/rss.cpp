@@ -0,0 +1,68 @@
+#include "../common/common.h"
+#include "radix.h"
+
+struct SerialRadixRun {
+    int size, seed;
+
+    template <typename T>
+    void run() {
+        T *array = randKeyArray<T>(size, seed);
+
+        std::cout << "\nSorting " << size << " " << KeyTraits<T>::name() << " keys..." << std::endl;
+        printKeys(array, size, "Random Array");
+
+        auto start = std::chrono::high_resolution_clock::now();
+        sortlib::radixSortSerial(array, size);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        printKeys(array, size, "Sorted Array");
+
+        std::chrono::duration<double> duration = end - start;
+        std::cout << "Serial Radix Sort Time: " << duration.count() << " seconds" << std::endl;
+
+        if (isSortedKeys(array, size)) {
+            std::cout << "Successfully sorted!" << std::endl;
+        } else {
+            std::cout << "Sorting failed!" << std::endl;
+        }
+
+        delete[] array;
+    }
+};
+
+int main(int argc, char **argv) {
+    int size, seed;
+    std::string type = "int32";
+
+    if (argc == 3 || argc == 4) {
+        // Command line mode
+        size = std::stoi(argv[1]);
+        seed = std::stoi(argv[2]);
+        if (argc == 4) type = argv[3];
+    } else {
+        // Interactive mode
+        std::cout << "Serial Radix Sort" << std::endl;
+        size = getUserInput();
+        std::cout << "Enter seed value for random number generation: ";
+        std::cin >> seed;
+        std::cout << "Enter key type (" << KEY_TYPE_NAMES << "): ";
+        std::cin >> type;
+    }
+
+    // Validation
+    if (size < 1) {
+        std::cerr << "Size must be at least 1 element." << std::endl;
+        return -1;
+    }
+    if (size > MAX_ELEMENTS) {
+        std::cerr << "Size cannot exceed " << MAX_ELEMENTS << " elements." << std::endl;
+        return -1;
+    }
+
+    SerialRadixRun radixRun = {size, seed};
+    if (!dispatchKeyType(type, radixRun)) {
+        std::cerr << "Unknown key type '" << type << "' (expected " << KEY_TYPE_NAMES << ")." << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include "common/common.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+// Strong and weak scaling study for the parallel executables.
+//
+// Each parallel executable is run with OMP_NUM_THREADS = 1, 2, 4, ... P,
+// pinned with OMP_PROC_BIND=close and OMP_PLACES=cores, and compared with
+// its serial counterpart at the same array size:
+//   speedup     S = T_serial / T_parallel
+//   efficiency  E = S / p
+//   Karp-Flatt  e = (1/S - 1/p) / (1 - 1/p)   (experimentally determined serial fraction)
+// Strong scaling keeps n fixed; weak scaling runs n * p elements on p
+// threads and also reports the scaled efficiency T_parallel(1, n) / T_parallel(p, n * p).
+// Every run's time is the median over the repetitions. Rows are appended
+// to a CSV file so results from different machines and days can be compared.
+// pps is compared with mss even though its time also covers producing the
+// input, since overlapping input with sorting is what it measures.
+
+struct EnginePair {
+    const char *parallel;
+    const char *serial;
+};
+
+const EnginePair ENGINES[] = {
+    {"bsp", "bss"},
+    {"msp", "mss"},
+    {"mlp", "mss"},
+    {"nmp", "mss"},
+    {"pps", "mss"},
+    {"mwp", "mss"},
+    {"qsp", "qss"},
+    {"rsp", "rss"},
+    {"ssp", "sss"}
+};
+
+const int NUM_ENGINES = sizeof(ENGINES) / sizeof(ENGINES[0]);
+
+// Extracts the sort time from an executable's output: the number after the
+// last "Sort Time:" (pps also prints partial times before its total).
+double parseTime(const std::string &output) {
+    std::istringstream lines(output);
+    std::string line;
+    double seconds = -1.0;
+    while (std::getline(lines, line)) {
+        size_t pos = line.find("Sort Time:");
+        if (pos != std::string::npos) {
+            seconds = std::atof(line.c_str() + pos + 10);
+        }
+    }
+    return seconds;
+}
+
+// Runs one executable and returns its reported sort time (median of
+// 'reps' runs), or -1 if it could not be run or printed no time.
+double timeRun(const std::string &dir, const char *executable, int size, int seed, int threads, int reps) {
+    std::ostringstream command;
+    if (threads > 0) {
+        command << "OMP_NUM_THREADS=" << threads << " OMP_PROC_BIND=close OMP_PLACES=cores ";
+    }
+    command << "'" << dir << executable << "' " << size << " " << seed << " 2>&1";
+
+    std::vector<double> times;
+    for (int r = 0; r < reps; r++) {
+        FILE *pipe = popen(command.str().c_str(), "r");
+        if (pipe == nullptr) {
+            return -1.0;
+        }
+        std::string output;
+        char chunk[4096];
+        size_t read;
+        while ((read = fread(chunk, 1, sizeof(chunk), pipe)) > 0) {
+            output.append(chunk, read);
+        }
+        int status = pclose(pipe);
+        double seconds = parseTime(output);
+        if (status != 0 || seconds < 0) {
+            std::cerr << "Run failed: " << command.str() << std::endl << output;
+            return -1.0;
+        }
+        times.push_back(seconds);
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        std::cerr << "usage: " << argv[0]
+                  << " [parallel executable] [array size] [seed] [max threads] [strong|weak|both] [repetitions] [results.csv]"
+                  << std::endl;
+        std::cerr << "parallel executables:";
+        for (int i = 0; i < NUM_ENGINES; i++) std::cerr << " " << ENGINES[i].parallel;
+        std::cerr << std::endl;
+        return -1;
+    }
+
+    std::string engine = argv[1];
+    int size = std::stoi(argv[2]);
+    int seed = std::stoi(argv[3]);
+    int maxThreads = argc > 4 ? std::stoi(argv[4]) : static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+    std::string mode = argc > 5 ? argv[5] : "both";
+    int reps = argc > 6 ? std::stoi(argv[6]) : 3;
+    std::string csvPath = argc > 7 ? argv[7] : "scaling_results.csv";
+
+    const EnginePair *pair = nullptr;
+    for (int i = 0; i < NUM_ENGINES; i++) {
+        if (engine == ENGINES[i].parallel) pair = &ENGINES[i];
+    }
+
+    // Validation
+    if (pair == nullptr) {
+        std::cerr << "Unknown parallel executable '" << engine << "'." << std::endl;
+        return -1;
+    }
+    if (size < 1 || size > MAX_ELEMENTS) {
+        std::cerr << "Size must be between 1 and " << MAX_ELEMENTS << " elements." << std::endl;
+        return -1;
+    }
+    if (maxThreads < 1 || reps < 1) {
+        std::cerr << "Max threads and repetitions must be at least 1." << std::endl;
+        return -1;
+    }
+    if (mode != "strong" && mode != "weak" && mode != "both") {
+        std::cerr << "Unknown mode '" << mode << "' (expected strong, weak or both)." << std::endl;
+        return -1;
+    }
+
+    // Executables are expected next to this one
+    std::string self = argv[0];
+    size_t slash = self.rfind('/');
+    std::string dir = slash == std::string::npos ? "./" : self.substr(0, slash + 1);
+
+    std::vector<int> threadCounts;
+    for (int p = 1; p < maxThreads; p *= 2) threadCounts.push_back(p);
+    threadCounts.push_back(maxThreads);
+
+    bool newFile = !std::ifstream(csvPath.c_str()).good();
+    std::ofstream csv(csvPath.c_str(), std::ios::app);
+    if (!csv) {
+        std::cerr << "Cannot open '" << csvPath << "' for writing." << std::endl;
+        return -1;
+    }
+    if (newFile) {
+        csv << "timestamp,host,engine,serial,mode,threads,size,seed,serial_seconds,parallel_seconds,"
+               "speedup,efficiency,karp_flatt,scaled_efficiency" << std::endl;
+    }
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+    char stamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::cout << "Scaling study: " << pair->parallel << " vs " << pair->serial << ", n = " << size
+              << ", seed = " << seed << ", up to " << maxThreads << " threads, " << reps
+              << " repetition(s) per point" << std::endl;
+
+    // Serial baselines depend only on n, so each distinct n is timed once
+    std::map<long long, double> serialTimes;
+    const char *modes[] = {"strong", "weak"};
+    for (const char *current : modes) {
+        if (mode != "both" && mode != current) continue;
+        bool weak = std::string(current) == "weak";
+
+        std::cout << "\n" << (weak ? "Weak" : "Strong") << " scaling" << std::endl;
+        std::cout << std::left << std::setw(9) << "Threads" << std::setw(11) << "Size"
+                  << std::setw(13) << "Serial(s)" << std::setw(13) << "Parallel(s)"
+                  << std::setw(10) << "Speedup" << std::setw(12) << "Efficiency"
+                  << std::setw(12) << "Karp-Flatt";
+        if (weak) std::cout << "Scaled Eff.";
+        std::cout << std::endl;
+
+        double baseParallel = -1.0;
+        for (int p : threadCounts) {
+            long long n = weak ? static_cast<long long>(size) * p : size;
+            if (n > MAX_ELEMENTS) {
+                std::cout << "(stopping: " << n << " elements exceeds " << MAX_ELEMENTS << ")" << std::endl;
+                break;
+            }
+            if (serialTimes.count(n) == 0) {
+                serialTimes[n] = timeRun(dir, pair->serial, static_cast<int>(n), seed, 0, reps);
+            }
+            double serial = serialTimes[n];
+            double parallel = timeRun(dir, pair->parallel, static_cast<int>(n), seed, p, reps);
+            if (serial <= 0 || parallel <= 0) {
+                return -1;
+            }
+            if (p == 1) baseParallel = parallel;
+
+            double speedup = serial / parallel;
+            double efficiency = speedup / p;
+            std::string karpFlatt = "";
+            std::string scaled = "";
+            if (p > 1) {
+                std::ostringstream value;
+                value << (1.0 / speedup - 1.0 / p) / (1.0 - 1.0 / p);
+                karpFlatt = value.str();
+            }
+            if (weak && baseParallel > 0) {
+                std::ostringstream value;
+                value << baseParallel / parallel;
+                scaled = value.str();
+            }
+
+            std::cout << std::left << std::setw(9) << p << std::setw(11) << n
+                      << std::setw(13) << serial << std::setw(13) << parallel
+                      << std::setw(10) << speedup << std::setw(12) << efficiency
+                      << std::setw(12) << (karpFlatt.empty() ? "-" : karpFlatt) << scaled << std::endl;
+            csv << stamp << "," << host << "," << pair->parallel << "," << pair->serial << ","
+                << current << "," << p << "," << n << "," << seed << "," << serial << "," << parallel << ","
+                << speedup << "," << efficiency << "," << karpFlatt << "," << scaled << std::endl;
+        }
+    }
+
+    std::cout << "\nResults appended to " << csvPath << std::endl;
+    return 0;
+}
@@ -1,23 +1,56 @@
 #ifndef SORT_H
 #define SORT_H
 
+// Header-only sort library. Every engine takes a random-access iterator
+// range and an optional comparator:
+//
+//   sortlib::mergeSortParallel(array, array + size);
+//   sortlib::quickSortSerial(records.begin(), records.end(), sortlib::byKey([](const Record &r) { return r.id; }));
+//
+// Parallel engines use OpenMP tasks when compiled with OpenMP and fall back
+// to the serial engine otherwise. Everything is declared in namespace
+// sortlib (internals in sortlib::detail), so the headers can be included
+// next to code with its own sort helpers.
+
+#include "sortlib/detail.h"
+
 // Bubble sort implementations
-void bubbleSortSerial(int* array, int size);
-void bubbleSortParallel(int* array, int size);
+#include "sortlib/bubble.h"
 
 // Quick sort implementations
-void quickSortSerial(int* array, int low, int high);
-void quickSortParallel(int* array, int low, int high);
+#include "sortlib/quick.h"
 
 // Merge sort implementations
-void mergeSortSerial(int* array, int left, int right);
-void mergeSortParallel(int* array, int left, int right);
+#include "sortlib/merge.h"
+
+// Memory-lean merge sort (bounded auxiliary space)
+#include "sortlib/lean.h"
+
+// Natural merge sort (run detection + powersort merge tree)
+#include "sortlib/natural.h"
+
+// Cache-aware multiway merge sort (tiles + loser-tree merge)
+#include "sortlib/multiway.h"
+
+// Sort-based unique, group-by count and per-key aggregation
+#include "sortlib/group.h"
+
+// Radix sort implementations (typed keys, see common/keys.h)
+#include "radixSort/radix.h"
+
+namespace sortlib {
 
 // STL sort reference
-void stlSort(int* array, int size);
+template <typename RandomIt, typename Compare>
+void stlSort(RandomIt first, RandomIt last, Compare comp) {
+    std::sort(first, last, comp);
+}
+
+template <typename RandomIt>
+void stlSort(RandomIt first, RandomIt last) {
+    std::sort(first, last);
+}
 
-// Helper functions
-int partition(int* array, int low, int high);
-void merge(int* array, int left, int mid, int right);
+} // namespace sortlib
 
-#endif
\ No newline at end of file
+#endif
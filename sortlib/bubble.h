@@ -0,0 +1,67 @@
+#ifndef SORTLIB_BUBBLE_H
+#define SORTLIB_BUBBLE_H
+
+#include "detail.h"
+
+// Bubble sort (O(n^2)).
+
+namespace sortlib {
+
+template <typename RandomIt, typename Compare>
+void bubbleSortSerial(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename std::iterator_traits<RandomIt>::difference_type Index;
+    const Index size = last - first;
+    for (Index i = 0; i < size - 1; i++) {
+        bool swapped = false;
+        for (Index j = 0; j < size - i - 1; j++) {
+            if (comp(first[j + 1], first[j])) {
+                std::iter_swap(first + j, first + j + 1);
+                swapped = true;
+            }
+        }
+        if (!swapped) break;
+    }
+}
+
+#ifdef _OPENMP
+// Odd-even transposition sort: the compare-swaps of one phase touch
+// disjoint pairs, so each phase is a parallel loop.
+template <typename RandomIt, typename Compare>
+void bubbleSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename std::iterator_traits<RandomIt>::difference_type Index;
+    const Index size = last - first;
+    bool sorted = false;
+    while (!sorted) {
+        sorted = true;
+        for (Index phase = 1; phase >= 0; phase--) {
+#pragma omp parallel for reduction(&& : sorted)
+            for (Index i = phase; i < size - 1; i += 2) {
+                if (comp(first[i + 1], first[i])) {
+                    std::iter_swap(first + i, first + i + 1);
+                    sorted = false;
+                }
+            }
+        }
+    }
+}
+#else
+// Without OpenMP the parallel engine falls back to the serial one.
+template <typename RandomIt, typename Compare>
+void bubbleSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    bubbleSortSerial(first, last, comp);
+}
+#endif
+
+template <typename RandomIt>
+void bubbleSortSerial(RandomIt first, RandomIt last) {
+    bubbleSortSerial(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+template <typename RandomIt>
+void bubbleSortParallel(RandomIt first, RandomIt last) {
+    bubbleSortParallel(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+} // namespace sortlib
+
+#endif
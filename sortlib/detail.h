@@ -0,0 +1,162 @@
+#ifndef SORTLIB_DETAIL_H
+#define SORTLIB_DETAIL_H
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Shared building blocks of the header-only sort library. Every engine is a
+// template over a random-access iterator and a comparator, so the comparator
+// (and any key extractor wrapped in it) is inlined into the kernel at
+// compile time instead of being called through a function pointer.
+//
+// Everything lives in namespace sortlib; helpers that are not part of the
+// interface are in sortlib::detail.
+
+namespace sortlib {
+
+namespace detail {
+
+// Ranges at or below this size are finished with insertion sort
+const int LEAF_THRESHOLD = 16;
+// Ranges above this size are split into OpenMP tasks
+const int TASK_THRESHOLD = 1000;
+
+} // namespace detail
+
+// Compares elements by a key: comp(extract(a), extract(b)).
+template <typename Extract, typename Compare>
+struct KeyCompare {
+    Extract extract;
+    Compare comp;
+
+    template <typename T>
+    bool operator()(const T &a, const T &b) const { return comp(extract(a), extract(b)); }
+};
+
+// byKey([](const Record &r) { return r.id; }) sorts records by id.
+template <typename Extract>
+KeyCompare<Extract, std::less<void> > byKey(Extract extract) {
+    KeyCompare<Extract, std::less<void> > compare = {extract, std::less<void>()};
+    return compare;
+}
+
+template <typename Extract, typename Compare>
+KeyCompare<Extract, Compare> byKey(Extract extract, Compare comp) {
+    KeyCompare<Extract, Compare> compare = {extract, comp};
+    return compare;
+}
+
+namespace detail {
+
+// Leaf insertion sort. The generic version shifts one element at a time;
+// for contiguous ranges of trivially copyable values the insertion point is
+// found by binary search and the block is shifted with one memmove.
+template <typename RandomIt, typename Compare>
+void insertionSortLeaf(RandomIt first, RandomIt last, Compare comp, std::false_type) {
+    if (first == last) return;
+    for (RandomIt i = first + 1; i != last; ++i) {
+        typename std::iterator_traits<RandomIt>::value_type key = std::move(*i);
+        RandomIt j = i;
+        while (j != first && comp(key, *(j - 1))) {
+            *j = std::move(*(j - 1));
+            --j;
+        }
+        *j = std::move(key);
+    }
+}
+
+template <typename T, typename Compare>
+void insertionSortLeaf(T *first, T *last, Compare comp, std::true_type) {
+    if (first == last) return;
+    for (T *i = first + 1; i != last; ++i) {
+        if (!comp(*i, *(i - 1))) continue;
+        T key = *i;
+        T *pos = std::upper_bound(first, i, key, comp);
+        std::memmove(pos + 1, pos, (i - pos) * sizeof(T));
+        *pos = key;
+    }
+}
+
+// Iterators known to address contiguous memory: raw pointers (which covers
+// std::array) and std::vector iterators, except the bit-packed
+// std::vector<bool>. Other contiguous containers take the generic leaf.
+template <typename RandomIt, typename T = typename std::iterator_traits<RandomIt>::value_type>
+struct IsContiguousIterator
+    : std::integral_constant<bool, std::is_pointer<RandomIt>::value ||
+                                   (!std::is_same<T, bool>::value &&
+                                    std::is_same<RandomIt, typename std::vector<T>::iterator>::value)> {};
+
+template <typename RandomIt>
+struct IsTrivialContiguous
+    : std::integral_constant<bool, IsContiguousIterator<RandomIt>::value &&
+                                   std::is_trivially_copyable<typename std::iterator_traits<RandomIt>::value_type>::value> {};
+
+template <typename RandomIt, typename Compare>
+void insertionSortDispatch(RandomIt first, RandomIt last, Compare comp, std::false_type) {
+    insertionSortLeaf(first, last, comp, std::false_type());
+}
+
+// Contiguous iterators are unwrapped to raw pointers for the memmove leaf.
+template <typename RandomIt, typename Compare>
+void insertionSortDispatch(RandomIt first, RandomIt last, Compare comp, std::true_type) {
+    if (first == last) return;
+    typename std::iterator_traits<RandomIt>::value_type *data = &*first;
+    insertionSortLeaf(data, data + (last - first), comp, std::true_type());
+}
+
+template <typename RandomIt, typename Compare>
+void insertionSort(RandomIt first, RandomIt last, Compare comp) {
+    insertionSortDispatch(first, last, comp, IsTrivialContiguous<RandomIt>());
+}
+
+// Merge scratch space for the range [first, last) (or for n elements).
+// Trivially copyable elements get uninitialized storage: every merge writes
+// its part of the buffer before reading it, so copying the input there
+// would only cost an extra pass over memory. Other types need constructed
+// objects to assign to and are copied from the range.
+template <typename T, bool Raw = std::is_trivially_copyable<T>::value>
+class Scratch {
+public:
+    template <typename It>
+    Scratch(It first, It last) : data(allocate(static_cast<size_t>(last - first))) {}
+    explicit Scratch(size_t n) : data(allocate(n)) {}
+    ~Scratch() { ::operator delete(data); }
+
+    T *begin() { return data; }
+
+private:
+    Scratch(const Scratch &);
+    Scratch &operator=(const Scratch &);
+
+    static T *allocate(size_t n) { return static_cast<T *>(::operator new(sizeof(T) * n)); }
+
+    T *data;
+};
+
+template <typename T>
+class Scratch<T, false> {
+public:
+    template <typename It>
+    Scratch(It first, It last) : data(first, last) {}
+    explicit Scratch(size_t n) : data(n) {}
+
+    T *begin() { return data.data(); }
+
+private:
+    std::vector<T> data;
+};
+
+} // namespace detail
+
+} // namespace sortlib
+
+#endif
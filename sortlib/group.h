@@ -0,0 +1,444 @@
+#ifndef SORTLIB_GROUP_H
+#define SORTLIB_GROUP_H
+
+#include "merge.h"
+#include <vector>
+
+// Sort-based unique, group-by count and per-key aggregation with early
+// aggregation: instead of sorting everything and then making a pass over
+// the output, every merge sort step folds equivalent elements into one
+// group as soon as they meet. A sorted subrange is kept as its distinct
+// group heads packed at the front, so with few distinct keys the data
+// shrinks level by level and the upper merges only touch the groups. The
+// final merge of the two halves is split into output ranges by co-ranking
+// (one per thread); a group cut by a range boundary is stitched back
+// together afterwards, and the groups are compacted to the front.
+//
+// Groups keep their first element (the merges are stable) and are returned
+// in [first, newEnd). Aggregations over a separate value array sort
+// (key, value) pairs with byKey() and read the value with the 'value'
+// functor.
+
+namespace sortlib {
+
+namespace detail {
+
+// Group bookkeeping for unique: nothing besides the element itself.
+//
+// The group operations take positions in the range being sorted (spilled
+// totals use the same positions in a second array, like the merge buffer):
+// start/add fold raw elements in a leaf, spill/unspill move the totals of
+// a left half out of the way and back, keep moves a total and fold
+// combines the totals of the same group from both halves. The final merge
+// numbers groups per segment; a Segment tracks the group currently being
+// emitted by one segment.
+struct UniqueGroups {
+    struct Segment {
+        void start(long long) {}
+        void add(long long) {}
+        void finish() {}
+    };
+
+    template <typename T>
+    void start(long long, const T &) {}
+    template <typename T>
+    void add(long long, const T &) {}
+    void spill(long long) {}
+    void unspill(long long, long long) {}
+    void keep(long long, long long) {}
+    void fold(long long, long long) {}
+    void collect(long long) {}
+
+    void segments(int) {}
+    Segment segment(int) { return Segment(); }
+    void combine(int, int) {}
+    void finish(size_t) {}
+    void store(size_t, int, size_t) {}
+};
+
+// Group bookkeeping for aggregations: the total value(e0) op value(e1) ...
+// of every group is kept next to its head, in an array with one slot per
+// position of the range. During the final merge, the running total of the
+// current group is kept in a register and appended to its segment's
+// partial totals when the next group starts. Finished totals are moved to
+// 'totals' during compaction.
+template <typename Value, typename Op, typename V>
+struct ReduceGroups {
+    struct Segment {
+        Op op;
+        const V *total;
+        std::vector<V> *partial;
+        V current;
+        bool open;
+
+        void start(long long position) {
+            if (open) partial->push_back(current);
+            current = total[position];
+            open = true;
+        }
+        void add(long long position) { current = op(current, total[position]); }
+        void finish() {
+            if (open) partial->push_back(current);
+        }
+    };
+
+    Value value;
+    Op op;
+    std::vector<V> &totals;
+    Scratch<V> total, spilled;
+    std::vector<std::vector<V> > partial;
+
+    ReduceGroups(Value value, Op op, std::vector<V> &totals, size_t n)
+        : value(value), op(op), totals(totals), total(n), spilled(n) {}
+
+    template <typename T>
+    void start(long long position, const T &element) { total.begin()[position] = value(element); }
+    template <typename T>
+    void add(long long position, const T &element) {
+        total.begin()[position] = op(total.begin()[position], value(element));
+    }
+    void spill(long long position) { spilled.begin()[position] = total.begin()[position]; }
+    void unspill(long long to, long long from) { total.begin()[to] = spilled.begin()[from]; }
+    void keep(long long to, long long from) { total.begin()[to] = total.begin()[from]; }
+    void fold(long long into, long long from) {
+        total.begin()[into] = op(total.begin()[into], total.begin()[from]);
+    }
+    void collect(long long groups) { totals.assign(total.begin(), total.begin() + groups); }
+
+    void segments(int count) { partial.assign(count, std::vector<V>()); }
+    Segment segment(int t) {
+        Segment segment = {op, total.begin(), &partial[t], V(), false};
+        return segment;
+    }
+    // Folds the first group of segment 'from' into the last group of 'into'
+    void combine(int into, int from) { partial[into].back() = op(partial[into].back(), partial[from].front()); }
+    void finish(size_t groups) { totals.resize(groups); }
+    void store(size_t to, int t, size_t g) { totals[to] = partial[t][g]; }
+};
+
+// Sorts the leaf [first + lo, first + hi) and packs its group heads at
+// first + lo. Returns the number of groups.
+template <typename RandomIt, typename Compare, typename Groups>
+long long groupLeaf(RandomIt first, long long lo, long long hi, Compare comp, Groups &groups) {
+    insertionSort(first + lo, first + hi, comp);
+    long long next = lo;
+    for (long long i = lo; i < hi; i++) {
+        if (next != lo && !comp(first[next - 1], first[i])) {
+            groups.add(next - 1, first[i]);
+        } else {
+            groups.start(next, first[i]);
+            if (next != i) first[next] = std::move(first[i]);
+            next++;
+        }
+    }
+    return next - lo;
+}
+
+// Merges the group heads [lo, lo + g1) and [mid, mid + g2) (positions in
+// first) into [lo, lo + groups), folding a group found in both halves into
+// one. As in mergeHalves, the left heads go through 'buffer' and ties take
+// the left head. Both halves hold distinct heads, so the equality test is
+// only needed after the left head is taken. Returns the number of groups.
+template <typename RandomIt, typename BufferIt, typename Compare, typename Groups>
+long long mergeGroupRuns(RandomIt first, long long lo, long long g1, long long mid, long long g2, BufferIt buffer,
+                         Compare comp, Groups &groups) {
+    long long k = lo + g1;
+    if (comp(first[k - 1], first[mid])) {
+        // Already ordered: the right heads only move down
+        for (long long j = mid; j < mid + g2; j++, k++) {
+            if (k == j) break;
+            first[k] = std::move(first[j]);
+            groups.keep(k, j);
+        }
+        return g1 + g2;
+    }
+    for (long long i = lo; i < lo + g1; i++) {
+        buffer[i] = std::move(first[i]);
+        groups.spill(i);
+    }
+    long long i = lo, iEnd = lo + g1, j = mid, jEnd = mid + g2;
+    k = lo;
+    while (i != iEnd && j != jEnd) {
+        if (comp(first[j], buffer[i])) {
+            first[k] = std::move(first[j]);
+            groups.keep(k, j++);
+        } else {
+            bool same = !comp(buffer[i], first[j]);
+            first[k] = std::move(buffer[i]);
+            groups.unspill(k, i++);
+            if (same) groups.fold(k, j++);
+        }
+        k++;
+    }
+    for (; i != iEnd; i++, k++) {
+        first[k] = std::move(buffer[i]);
+        groups.unspill(k, i);
+    }
+    for (; j != jEnd && k != j; j++, k++) {
+        first[k] = std::move(first[j]);
+        groups.keep(k, j);
+    }
+    return k + (jEnd - j) - lo;
+}
+
+template <typename RandomIt, typename BufferIt, typename Compare, typename Groups>
+long long groupSortSerial(RandomIt first, long long lo, long long hi, BufferIt buffer, Compare comp,
+                          Groups &groups) {
+    if (hi - lo <= LEAF_THRESHOLD) return groupLeaf(first, lo, hi, comp, groups);
+    long long mid = lo + (hi - lo) / 2;
+    long long g1 = groupSortSerial(first, lo, mid, buffer, comp, groups);
+    long long g2 = groupSortSerial(first, mid, hi, buffer, comp, groups);
+    return mergeGroupRuns(first, lo, g1, mid, g2, buffer, comp, groups);
+}
+
+// Number of left-run elements among the first k outputs of a stable merge
+// of the sorted runs [left, left + n1) and [right, right + n2).
+template <typename RandomIt, typename Compare>
+long long coRank(long long k, RandomIt left, long long n1, RandomIt right, long long n2, Compare comp) {
+    long long lo = k > n2 ? k - n2 : 0;
+    long long hi = k < n1 ? k : n1;
+    while (lo < hi) {
+        long long i = lo + (hi - lo) / 2;
+        if (!comp(right[k - i - 1], left[i])) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+// Stable merge of the group heads [a, aEnd) and [b, bEnd) (positions in
+// first) that writes one element per group to 'out' (segment t of the
+// final merge). Returns the number of groups.
+template <typename RandomIt, typename BufferIt, typename Compare, typename Groups>
+size_t mergeGroups(RandomIt first, long long a, long long aEnd, long long b, long long bEnd, BufferIt out,
+                   Compare comp, Groups &groups, int t) {
+    typename Groups::Segment segment = groups.segment(t);
+    BufferIt next = out;
+    while (a != aEnd && b != bEnd) {
+        if (comp(first[b], first[a])) {
+            segment.start(b);
+            *next++ = std::move(first[b++]);
+        } else {
+            bool same = !comp(first[a], first[b]);
+            segment.start(a);
+            *next++ = std::move(first[a++]);
+            if (same) segment.add(b++);
+        }
+    }
+    for (; a != aEnd; a++) {
+        segment.start(a);
+        *next++ = std::move(first[a]);
+    }
+    for (; b != bEnd; b++) {
+        segment.start(b);
+        *next++ = std::move(first[b]);
+    }
+    segment.finish();
+    return next - out;
+}
+
+// Joins groups cut by a segment boundary and compacts the groups of all
+// segments to 'first'. Segment t holds groupCount[t] groups at
+// buffer + segmentStart[t]. Returns the end of the compacted groups.
+template <typename RandomIt, typename BufferIt, typename Compare, typename Groups>
+RandomIt stitchGroups(RandomIt first, BufferIt buffer, Compare comp, Groups &groups, int segments,
+                      const std::vector<size_t> &segmentStart, const std::vector<size_t> &groupCount) {
+    // A group cut by a boundary continues in the first group of the next
+    // non-empty segment, which is then folded into it and skipped
+    std::vector<size_t> skip(segments, 0);
+    int owner = -1;
+    for (int t = 0; t < segments; t++) {
+        if (groupCount[t] == 0) continue;
+        if (owner >= 0) {
+            size_t last = segmentStart[owner] + groupCount[owner] - 1;
+            if (!comp(buffer[last], buffer[segmentStart[t]])) {
+                groups.combine(owner, t);
+                skip[t] = 1;
+            }
+        }
+        if (groupCount[t] > skip[t]) owner = t;
+    }
+
+    std::vector<size_t> offset(segments + 1, 0);
+    for (int t = 0; t < segments; t++) {
+        offset[t + 1] = offset[t] + groupCount[t] - skip[t];
+    }
+    groups.finish(offset[segments]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1) if (segments > 1)
+#endif
+    for (int t = 0; t < segments; t++) {
+        for (size_t g = skip[t]; g < groupCount[t]; g++) {
+            first[offset[t] + g - skip[t]] = std::move(buffer[segmentStart[t] + g]);
+            groups.store(offset[t] + g - skip[t], t, g);
+        }
+    }
+    return first + offset[segments];
+}
+
+// Merges segment t of the final merge of the group heads [0, g1) and
+// [mid, mid + g2). split[t] is the number of left heads before output
+// position segmentStart[t]; the splits are co-ranked before any segment
+// starts moving heads out of 'first', which would leave moved-from
+// elements behind for the binary searches of the other segments.
+template <typename RandomIt, typename BufferIt, typename Compare, typename Groups>
+void mergeSegment(RandomIt first, long long mid, BufferIt buffer, Compare comp, Groups &groups, int t,
+                  const std::vector<size_t> &segmentStart, const std::vector<long long> &split,
+                  std::vector<size_t> &groupCount) {
+    long long kBegin = static_cast<long long>(segmentStart[t]);
+    long long kEnd = static_cast<long long>(segmentStart[t + 1]);
+    long long iBegin = split[t], iEnd = split[t + 1];
+    groupCount[t] = mergeGroups(first, iBegin, iEnd, mid + (kBegin - iBegin), mid + (kEnd - iEnd),
+                                buffer + kBegin, comp, groups, t);
+}
+
+template <typename RandomIt, typename Compare, typename Groups>
+RandomIt sortGroupsSerial(RandomIt first, RandomIt last, Compare comp, Groups &groups) {
+    if (first == last) return last;
+    Scratch<typename std::iterator_traits<RandomIt>::value_type> buffer(first, last);
+    long long count = groupSortSerial(first, 0, last - first, buffer.begin(), comp, groups);
+    groups.collect(count);
+    return first + count;
+}
+
+#ifdef _OPENMP
+// Task parallelism for the division phase, as in mergeSortTasks.
+template <typename RandomIt, typename BufferIt, typename Compare, typename Groups>
+long long groupSortTasks(RandomIt first, long long lo, long long hi, BufferIt buffer, Compare comp,
+                         Groups &groups) {
+    if (hi - lo <= TASK_THRESHOLD) return groupSortSerial(first, lo, hi, buffer, comp, groups);
+    long long mid = lo + (hi - lo) / 2, g1, g2;
+#pragma omp task shared(g1, groups)
+    g1 = groupSortTasks(first, lo, mid, buffer, comp, groups);
+#pragma omp task shared(g2, groups)
+    g2 = groupSortTasks(first, mid, hi, buffer, comp, groups);
+#pragma omp taskwait
+    return mergeGroupRuns(first, lo, g1, mid, g2, buffer, comp, groups);
+}
+
+template <typename RandomIt, typename Compare, typename Groups>
+RandomIt sortGroupsParallel(RandomIt first, RandomIt last, Compare comp, Groups &groups) {
+    if (first == last) return last;
+    Scratch<typename std::iterator_traits<RandomIt>::value_type> buffer(first, last);
+    long long n = last - first, mid = n / 2, g1 = 0, g2 = 0;
+    int segments = 1;
+    std::vector<size_t> segmentStart, groupCount;
+    std::vector<long long> split;
+
+#pragma omp parallel
+    {
+#pragma omp single
+        {
+#pragma omp task shared(g1, groups)
+            g1 = groupSortTasks(first, 0, mid, buffer.begin(), comp, groups);
+#pragma omp task shared(g2, groups)
+            g2 = groupSortTasks(first, mid, n, buffer.begin(), comp, groups);
+#pragma omp taskwait
+
+            // One output range per thread, but no range below TASK_THRESHOLD
+            long long heads = g1 + g2;
+            segments = static_cast<int>(
+                std::min<long long>(omp_get_num_threads(), std::max(1LL, heads / TASK_THRESHOLD)));
+            groups.segments(segments);
+            segmentStart.resize(segments + 1);
+            groupCount.assign(segments, 0);
+            split.resize(segments + 1);
+            for (int t = 0; t <= segments; t++) {
+                segmentStart[t] = static_cast<size_t>(heads * t / segments);
+                split[t] = coRank(static_cast<long long>(segmentStart[t]), first, g1, first + mid, g2, comp);
+            }
+        }
+#pragma omp for schedule(static, 1)
+        for (int t = 0; t < segments; t++) {
+            mergeSegment(first, mid, buffer.begin(), comp, groups, t, segmentStart, split, groupCount);
+        }
+    }
+    return stitchGroups(first, buffer.begin(), comp, groups, segments, segmentStart, groupCount);
+}
+#else
+template <typename RandomIt, typename Compare, typename Groups>
+RandomIt sortGroupsParallel(RandomIt first, RandomIt last, Compare comp, Groups &groups) {
+    return sortGroupsSerial(first, last, comp, groups);
+}
+#endif
+
+} // namespace detail
+
+// Sorts [first, last) and keeps the first element of every run of
+// equivalent elements. Returns the end of the unique range.
+template <typename RandomIt, typename Compare>
+RandomIt sortUniqueSerial(RandomIt first, RandomIt last, Compare comp) {
+    detail::UniqueGroups groups;
+    return detail::sortGroupsSerial(first, last, comp, groups);
+}
+
+template <typename RandomIt, typename Compare>
+RandomIt sortUniqueParallel(RandomIt first, RandomIt last, Compare comp) {
+    detail::UniqueGroups groups;
+    return detail::sortGroupsParallel(first, last, comp, groups);
+}
+
+// Sorts [first, last), keeps one element per key and sets totals[g] to
+// value(e) op value(e') op ... over the elements of group g. 'op' must be
+// associative (partial totals of a group cut by a segment boundary are
+// combined with it).
+template <typename RandomIt, typename Compare, typename Value, typename Op, typename V>
+RandomIt sortReduceByKeySerial(RandomIt first, RandomIt last, Compare comp, Value value, Op op,
+                               std::vector<V> &totals) {
+    detail::ReduceGroups<Value, Op, V> groups(value, op, totals, static_cast<size_t>(last - first));
+    totals.clear();
+    return detail::sortGroupsSerial(first, last, comp, groups);
+}
+
+template <typename RandomIt, typename Compare, typename Value, typename Op, typename V>
+RandomIt sortReduceByKeyParallel(RandomIt first, RandomIt last, Compare comp, Value value, Op op,
+                                 std::vector<V> &totals) {
+    detail::ReduceGroups<Value, Op, V> groups(value, op, totals, static_cast<size_t>(last - first));
+    totals.clear();
+    return detail::sortGroupsParallel(first, last, comp, groups);
+}
+
+namespace detail {
+
+// Counts the elements of every group (run-length group counts).
+struct CountOne {
+    template <typename T>
+    long long operator()(const T &) const { return 1; }
+};
+
+} // namespace detail
+
+template <typename RandomIt, typename Compare>
+RandomIt sortGroupCountSerial(RandomIt first, RandomIt last, Compare comp, std::vector<long long> &counts) {
+    return sortReduceByKeySerial(first, last, comp, detail::CountOne(), std::plus<long long>(), counts);
+}
+
+template <typename RandomIt, typename Compare>
+RandomIt sortGroupCountParallel(RandomIt first, RandomIt last, Compare comp, std::vector<long long> &counts) {
+    return sortReduceByKeyParallel(first, last, comp, detail::CountOne(), std::plus<long long>(), counts);
+}
+
+template <typename RandomIt>
+RandomIt sortUniqueSerial(RandomIt first, RandomIt last) {
+    return sortUniqueSerial(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+template <typename RandomIt>
+RandomIt sortUniqueParallel(RandomIt first, RandomIt last) {
+    return sortUniqueParallel(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+template <typename RandomIt>
+RandomIt sortGroupCountSerial(RandomIt first, RandomIt last, std::vector<long long> &counts) {
+    return sortGroupCountSerial(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(),
+                                counts);
+}
+
+template <typename RandomIt>
+RandomIt sortGroupCountParallel(RandomIt first, RandomIt last, std::vector<long long> &counts) {
+    return sortGroupCountParallel(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(),
+                                  counts);
+}
+
+} // namespace sortlib
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef SORTLIB_LEAN_H
+#define SORTLIB_LEAN_H
+
+#include "detail.h"
+#include "merge.h"
+
+// Memory-lean merge sort, stable. Auxiliary space is capped by a budget
+// shared by all threads, instead of the n elements of mergeSort*. A merge
+// whose smaller run fits in the calling thread's buffer is a plain buffered
+// merge; otherwise both runs are split at matching ranks, the middle blocks
+// are swapped with an in-place rotation, and the two halves are merged
+// recursively. Ties always keep left-run elements first.
+
+namespace sortlib {
+
+namespace detail {
+
+// One merge buffer of 'size' elements per thread, carved from one block.
+// Tasks are tied and never hit a scheduling point while a buffer is in use,
+// so indexing by thread number is safe.
+template <typename T>
+struct LeanBuffers {
+    T *base;
+    long long size;
+    int count;
+
+    T *get() const {
+#ifdef _OPENMP
+        if (count > 1) return base + omp_get_thread_num() * size;
+#endif
+        return base;
+    }
+};
+
+template <typename RandomIt, typename Compare, typename T>
+void leanMerge(RandomIt first, RandomIt mid, RandomIt last, Compare comp, const LeanBuffers<T> &buffers) {
+    long long n1 = mid - first, n2 = last - mid;
+    if (n1 == 0 || n2 == 0 || !comp(*mid, *(mid - 1))) {
+        return;
+    }
+
+    if (n1 <= n2 && n1 <= buffers.size) {
+        // Forward merge with the left run in the buffer
+        mergeHalves(first, mid, last, buffers.get(), comp);
+        return;
+    }
+    if (n2 <= buffers.size) {
+        // Backward merge with the right run in the buffer
+        T *buffer = buffers.get();
+        T *j = std::move(mid, last, buffer);
+        RandomIt i = mid, k = last;
+        while (i != first && j != buffer) {
+            if (comp(*(j - 1), *(i - 1))) *--k = std::move(*--i);
+            else *--k = std::move(*--j);
+        }
+        std::move_backward(buffer, j, k);
+        return;
+    }
+
+    // Neither run fits: cut the longer run in half, find the matching cut in
+    // the other, and rotate the two middle blocks past each other
+    RandomIt cut1, cut2;
+    if (n1 >= n2) {
+        cut1 = first + n1 / 2;
+        cut2 = std::lower_bound(mid, last, *cut1, comp);
+    } else {
+        cut2 = mid + n2 / 2;
+        cut1 = std::upper_bound(first, mid, *cut2, comp);
+    }
+    RandomIt newMid = std::rotate(cut1, mid, cut2);
+
+#ifdef _OPENMP
+    if (buffers.count > 1 && last - first > TASK_THRESHOLD) {
+#pragma omp task
+        leanMerge(first, cut1, newMid, comp, buffers);
+#pragma omp task
+        leanMerge(newMid, cut2, last, comp, buffers);
+#pragma omp taskwait
+        return;
+    }
+#endif
+    leanMerge(first, cut1, newMid, comp, buffers);
+    leanMerge(newMid, cut2, last, comp, buffers);
+}
+
+// Division phase. With more than one buffer, subarrays above TASK_THRESHOLD
+// become tasks; with one (the serial engine) everything runs on the calling
+// thread, so the single buffer is never shared.
+template <typename RandomIt, typename Compare, typename T>
+void leanMergeSort(RandomIt first, RandomIt last, Compare comp, const LeanBuffers<T> &buffers) {
+    if (last - first <= LEAF_THRESHOLD) {
+        insertionSort(first, last, comp);
+        return;
+    }
+    RandomIt mid = first + (last - first) / 2;
+#ifdef _OPENMP
+    if (buffers.count > 1 && last - first > TASK_THRESHOLD) {
+#pragma omp task
+        leanMergeSort(first, mid, comp, buffers);
+#pragma omp task
+        leanMergeSort(mid, last, comp, buffers);
+#pragma omp taskwait
+        leanMerge(first, mid, last, comp, buffers);
+        return;
+    }
+#endif
+    leanMergeSort(first, mid, comp, buffers);
+    leanMergeSort(mid, last, comp, buffers);
+    leanMerge(first, mid, last, comp, buffers);
+}
+
+} // namespace detail
+
+// Elements of auxiliary space per thread when a budget of 'budget'
+// elements for n elements is split over 'threads' threads.
+inline long long leanBufferSize(long long n, long long budget, int threads) {
+    return std::max(1LL, std::min(budget, n) / threads);
+}
+
+// Sorts [first, last) with at most 'budget' elements of auxiliary space.
+template <typename RandomIt, typename Compare>
+void leanMergeSortSerial(RandomIt first, RandomIt last, Compare comp, long long budget) {
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    long long size = leanBufferSize(last - first, budget, 1);
+    detail::Scratch<T> storage(static_cast<size_t>(size));
+    detail::LeanBuffers<T> buffers = {storage.begin(), size, 1};
+    detail::leanMergeSort(first, last, comp, buffers);
+}
+
+#ifdef _OPENMP
+// The budget is split evenly over the threads of the team that runs the
+// tasks (the enclosing one when called inside a parallel region).
+template <typename RandomIt, typename Compare>
+void leanMergeSortParallel(RandomIt first, RandomIt last, Compare comp, long long budget) {
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    bool nested = omp_in_parallel();
+    int threads = nested ? omp_get_num_threads() : omp_get_max_threads();
+    long long size = leanBufferSize(last - first, budget, threads);
+    detail::Scratch<T> storage(static_cast<size_t>(size * threads));
+    detail::LeanBuffers<T> buffers = {storage.begin(), size, threads};
+    if (nested) {
+        detail::leanMergeSort(first, last, comp, buffers);
+        return;
+    }
+#pragma omp parallel
+    {
+#pragma omp single
+        detail::leanMergeSort(first, last, comp, buffers);
+    }
+}
+#else
+// Without OpenMP the parallel engine falls back to the serial one.
+template <typename RandomIt, typename Compare>
+void leanMergeSortParallel(RandomIt first, RandomIt last, Compare comp, long long budget) {
+    leanMergeSortSerial(first, last, comp, budget);
+}
+#endif
+
+template <typename RandomIt>
+void leanMergeSortSerial(RandomIt first, RandomIt last, long long budget) {
+    leanMergeSortSerial(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(), budget);
+}
+
+template <typename RandomIt>
+void leanMergeSortParallel(RandomIt first, RandomIt last, long long budget) {
+    leanMergeSortParallel(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(), budget);
+}
+
+} // namespace sortlib
+
+#endif
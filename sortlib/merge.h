@@ -0,0 +1,106 @@
+#ifndef SORTLIB_MERGE_H
+#define SORTLIB_MERGE_H
+
+#include "detail.h"
+
+// Merge sort (O(n log n) worst case), stable. One scratch buffer of n
+// elements is allocated per sort instead of two temporaries per merge.
+
+namespace sortlib {
+
+namespace detail {
+
+// Merges the sorted halves [first, mid) and [mid, last) through 'buffer'
+// (which must hold at least mid - first elements). Ties take the left half
+// first, which keeps the sort stable.
+template <typename RandomIt, typename BufferIt, typename Compare>
+void mergeHalves(RandomIt first, RandomIt mid, RandomIt last, BufferIt buffer, Compare comp) {
+    if (first == mid || mid == last || !comp(*mid, *(mid - 1))) {
+        return;
+    }
+    BufferIt bufferEnd = std::move(first, mid, buffer);
+    BufferIt i = buffer;
+    RandomIt j = mid, k = first;
+    while (i != bufferEnd && j != last) {
+        if (comp(*j, *i)) *k++ = std::move(*j++);
+        else *k++ = std::move(*i++);
+    }
+    std::move(i, bufferEnd, k);
+}
+
+template <typename RandomIt, typename BufferIt, typename Compare>
+void mergeSortSerial(RandomIt first, RandomIt last, BufferIt buffer, Compare comp) {
+    if (last - first <= LEAF_THRESHOLD) {
+        insertionSort(first, last, comp);
+        return;
+    }
+    RandomIt mid = first + (last - first) / 2;
+    mergeSortSerial(first, mid, buffer, comp);
+    mergeSortSerial(mid, last, buffer + (mid - first), comp);
+    mergeHalves(first, mid, last, buffer, comp);
+}
+
+} // namespace detail
+
+template <typename RandomIt, typename Compare>
+void mergeSortSerial(RandomIt first, RandomIt last, Compare comp) {
+    detail::Scratch<typename std::iterator_traits<RandomIt>::value_type> buffer(first, last);
+    detail::mergeSortSerial(first, last, buffer.begin(), comp);
+}
+
+#ifdef _OPENMP
+namespace detail {
+
+// Task parallelism for the division phase, as in the original msp: subarrays
+// above TASK_THRESHOLD are sorted as two tasks followed by a taskwait.
+template <typename RandomIt, typename BufferIt, typename Compare>
+void mergeSortTasks(RandomIt first, RandomIt last, BufferIt buffer, Compare comp) {
+    if (last - first <= TASK_THRESHOLD) {
+        mergeSortSerial(first, last, buffer, comp);
+        return;
+    }
+    RandomIt mid = first + (last - first) / 2;
+#pragma omp task
+    mergeSortTasks(first, mid, buffer, comp);
+#pragma omp task
+    mergeSortTasks(mid, last, buffer + (mid - first), comp);
+#pragma omp taskwait
+    mergeHalves(first, mid, last, buffer, comp);
+}
+
+} // namespace detail
+
+template <typename RandomIt, typename Compare>
+void mergeSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    detail::Scratch<typename std::iterator_traits<RandomIt>::value_type> buffer(first, last);
+    if (omp_in_parallel()) {
+        detail::mergeSortTasks(first, last, buffer.begin(), comp);
+        return;
+    }
+#pragma omp parallel
+    {
+#pragma omp single
+        detail::mergeSortTasks(first, last, buffer.begin(), comp);
+    }
+}
+#else
+// Without OpenMP the parallel engine falls back to the serial one.
+template <typename RandomIt, typename Compare>
+void mergeSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    mergeSortSerial(first, last, comp);
+}
+#endif
+
+template <typename RandomIt>
+void mergeSortSerial(RandomIt first, RandomIt last) {
+    mergeSortSerial(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+template <typename RandomIt>
+void mergeSortParallel(RandomIt first, RandomIt last) {
+    mergeSortParallel(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+} // namespace sortlib
+
+#endif
@@ -0,0 +1,335 @@
+#ifndef SORTLIB_MULTIWAY_H
+#define SORTLIB_MULTIWAY_H
+
+#include "merge.h"
+#include <unistd.h>
+#include <vector>
+
+// Cache-aware multiway merge sort, stable. The binary merge sort makes
+// log2(n / cache) full passes over main memory once subarrays outgrow the
+// cache. Here the array is cut into tiles that fit in half the L2 cache
+// (the other half holds the merge buffer), every tile is sorted in cache,
+// and then up to MULTIWAY_FANIN tiles are merged at once with a loser tree,
+// so one merge pass (two beyond MULTIWAY_FANIN tiles) touches DRAM.
+// The parallel engine sorts tiles in a parallel loop and splits every
+// merge pass into one output range per thread: multisequence co-ranking
+// finds where each range starts in every run.
+
+namespace sortlib {
+
+namespace detail {
+
+// Most runs merged by one loser tree
+const int MULTIWAY_FANIN = 512;
+
+// Elements per tile: half the L2 cache (256 KB assumed when unknown).
+template <typename T>
+long long cacheTileSize() {
+    long long l2 = 0;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    if (l2 <= 0) l2 = 256 * 1024;
+    return std::max<long long>(1024, l2 / 2 / static_cast<long long>(sizeof(T)));
+}
+
+// A sorted run [begin, end) taking part in a multiway merge.
+template <typename It>
+struct SortedRun {
+    It begin, end;
+};
+
+// Loser tree (tournament tree) over k runs. The head element of every run
+// is cached next to the tree, so a replay compares values in one small
+// array instead of chasing k iterators. The k leaves are tree positions
+// k..2k-1 (no padding to a power of two) and runs are placed on them in
+// left-to-right order, so ties go to the left subtree, i.e. to the earlier
+// run, which keeps the merge stable. An exhausted run is removed and the
+// tree rebuilt over the others, so a replay never checks whether a run is
+// still live.
+template <typename It, typename Compare>
+class LoserTree {
+public:
+    typedef typename std::iterator_traits<It>::value_type T;
+
+    LoserTree(const std::vector<SortedRun<It> > &runs, Compare comp) : comp(comp) {
+        std::vector<SortedRun<It> > live;
+        for (size_t i = 0; i < runs.size(); i++) {
+            if (runs[i].begin != runs[i].end) live.push_back(runs[i]);
+        }
+        place(live);
+    }
+
+    // Writes the next 'count' elements of the merge to out.
+    template <typename OutIt>
+    OutIt merge(OutIt out, long long count) {
+        int winner = tree[0];
+        for (long long n = 0; n < count; n++) {
+            T *heads = &head[0];
+            int *losers = &tree[0];
+            *out++ = heads[winner];
+            if (++current[winner] == end[winner]) {
+                remove(winner);
+                winner = tree[0];
+                continue;
+            }
+            heads[winner] = *current[winner];
+            winner = replay(heads, losers, winner, std::is_integral<T>());
+        }
+        tree[0] = winner;
+        return out;
+    }
+
+private:
+    // Plays the path from leaf 'winner' (whose head just changed) to the
+    // root and returns the new winner. Which side the path comes from at
+    // every node is known from the node index.
+    int replay(const T *heads, int *losers, int winner, std::false_type) {
+        for (int node = winner + leaves; node > 1; node /= 2) {
+            int fromRight = -(node & 1);
+            int other = losers[node / 2];
+            int right = other ^ ((other ^ winner) & fromRight), left = other ^ winner ^ right;
+            int next = play(heads, left, right, comp);
+            losers[node / 2] = left ^ right ^ next;
+            winner = next;
+        }
+        return winner;
+    }
+
+    // Integer keys: the winner's head is carried up the path in a register
+    // and selected with the same masks, so a match waits for the previous
+    // one's selects but not for a reload of the winner's head.
+    int replay(const T *heads, int *losers, int winner, std::true_type) {
+        T value = heads[winner];
+        for (int node = winner + leaves; node > 1; node /= 2) {
+            int fromRight = -(node & 1);
+            int other = losers[node / 2];
+            T challenger = heads[other];
+            T right = challenger ^ ((challenger ^ value) & static_cast<T>(fromRight));
+            T left = challenger ^ value ^ right;
+            int upset = -static_cast<int>(comp(right, left)) ^ fromRight;
+            int swap = (other ^ winner) & upset;
+            losers[node / 2] = other ^ swap;
+            winner ^= swap;
+            value ^= (value ^ challenger) & static_cast<T>(upset);
+        }
+        return winner;
+    }
+
+    // Returns the winner of the match between the left and right subtree
+    // leaves: the right one only wins when its head is strictly smaller,
+    // one comparison. The selects are written as masks because the compiler
+    // turns plain ternaries into branches, which mispredict on about half
+    // of the matches of a replay.
+    static int play(const T *heads, int left, int right, Compare &comp) {
+        return left ^ ((left ^ right) & -static_cast<int>(comp(heads[right], heads[left])));
+    }
+
+    // Leaf slot (tree position - k) of run q, counting leaves left to right:
+    // the bottom level holds positions 2^d..2k-1 (2^d the largest power of
+    // two below 2k), the level above positions k..2^d-1.
+    static int slot(int q, int k) {
+        int bottom = 1;
+        while (bottom * 2 < 2 * k) bottom *= 2;
+        int wrap = 2 * k - bottom;
+        return q < wrap ? bottom + q - k : q - wrap;
+    }
+
+    // Puts 'runs' on the leaves in order and plays the tree.
+    void place(const std::vector<SortedRun<It> > &runs) {
+        leaves = static_cast<int>(runs.size());
+        current.resize(leaves);
+        end.resize(leaves);
+        head.resize(leaves);
+        tree.assign(std::max(leaves, 1), 0);
+        for (int q = 0; q < leaves; q++) {
+            int s = slot(q, leaves);
+            current[s] = runs[q].begin;
+            end[s] = runs[q].end;
+            head[s] = *runs[q].begin;
+        }
+        if (leaves > 0) tree[0] = build(1);
+    }
+
+    // Drops the exhausted run on slot s; the others keep their order.
+    void remove(int s) {
+        std::vector<SortedRun<It> > live;
+        for (int q = 0; q < leaves; q++) {
+            int t = slot(q, leaves);
+            SortedRun<It> run = {current[t], end[t]};
+            if (t != s) live.push_back(run);
+        }
+        place(live);
+    }
+
+    // Plays the matches below 'node', storing losers; returns the winner.
+    int build(int node) {
+        if (node >= leaves) return node - leaves;
+        int left = build(2 * node), right = build(2 * node + 1);
+        int winner = play(&head[0], left, right, comp);
+        tree[node] = left ^ right ^ winner;
+        return winner;
+    }
+
+    Compare comp;
+    int leaves;
+    std::vector<It> current, end;
+    std::vector<T> head;
+    std::vector<int> tree; // tree[0] is the winner, tree[1..leaves) the losers
+};
+
+// Multisequence co-ranking: finds cut[q] in every run so that the first
+// 'rank' elements of the stable merge are exactly the prefixes
+// [runs[q].begin, runs[q].begin + cut[q]). Each step picks the middle of the
+// widest remaining candidate range as a pivot, computes its exact rank with
+// one binary search per run and narrows every run's range with it.
+template <typename It, typename Compare>
+void multiwayCoRank(const std::vector<SortedRun<It> > &runs, long long rank, Compare comp, std::vector<long long> &cut) {
+    int k = static_cast<int>(runs.size());
+    std::vector<long long> lo(k, 0), hi(k), position(k);
+    for (int q = 0; q < k; q++) hi[q] = runs[q].end - runs[q].begin;
+
+    while (true) {
+        int widest = -1;
+        for (int q = 0; q < k; q++) {
+            if (lo[q] < hi[q] && (widest < 0 || hi[q] - lo[q] > hi[widest] - lo[widest])) widest = q;
+        }
+        if (widest < 0) break;
+
+        long long mid = lo[widest] + (hi[widest] - lo[widest]) / 2;
+        const typename std::iterator_traits<It>::value_type &pivot = runs[widest].begin[mid];
+        long long pivotRank = 0;
+        for (int q = 0; q < k; q++) {
+            // Elements of run q that come before the pivot in the stable merge
+            if (q < widest) position[q] = std::upper_bound(runs[q].begin, runs[q].end, pivot, comp) - runs[q].begin;
+            else if (q > widest) position[q] = std::lower_bound(runs[q].begin, runs[q].end, pivot, comp) - runs[q].begin;
+            else position[q] = mid;
+            pivotRank += position[q];
+        }
+
+        if (pivotRank < rank) {
+            // The pivot and everything before it are inside the cut
+            for (int q = 0; q < k; q++) lo[q] = std::max(lo[q], position[q] + (q == widest ? 1 : 0));
+        } else {
+            for (int q = 0; q < k; q++) hi[q] = std::min(hi[q], position[q]);
+        }
+    }
+    cut = lo;
+}
+
+// Merges 'runs' into out, split into 'segments' output ranges that are
+// merged independently (in parallel when compiled with OpenMP).
+template <typename It, typename OutIt, typename Compare>
+void multiwayMerge(const std::vector<SortedRun<It> > &runs, OutIt out, Compare comp, int segments) {
+    if (runs.size() == 1) {
+        std::copy(runs[0].begin, runs[0].end, out);
+        return;
+    }
+    long long total = 0;
+    for (size_t q = 0; q < runs.size(); q++) total += runs[q].end - runs[q].begin;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1) if (segments > 1)
+#endif
+    for (int t = 0; t < segments; t++) {
+        long long first = total * t / segments, last = total * (t + 1) / segments;
+        std::vector<long long> begin, end;
+        multiwayCoRank(runs, first, comp, begin);
+        multiwayCoRank(runs, last, comp, end);
+        std::vector<SortedRun<It> > parts(runs.size());
+        for (size_t q = 0; q < runs.size(); q++) {
+            parts[q].begin = runs[q].begin + begin[q];
+            parts[q].end = runs[q].begin + end[q];
+        }
+        LoserTree<It, Compare> tree(parts, comp);
+        tree.merge(out + first, last - first);
+    }
+}
+
+// Tile sort followed by multiway merge passes, ping-ponging between the
+// array and 'buffer'. Tiles are copied to the buffer while still in cache
+// when that makes the last pass end in the array.
+template <typename RandomIt, typename BufferIt, typename Compare>
+void multiwayMergeSort(RandomIt first, RandomIt last, BufferIt buffer, Compare comp, int segments) {
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    long long n = last - first;
+    long long tile = cacheTileSize<T>();
+    long long tiles = (n + tile - 1) / tile;
+    if (tiles <= 1) {
+        mergeSortSerial(first, last, buffer, comp);
+        return;
+    }
+
+    int passes = 0;
+    for (long long runs = tiles; runs > 1; runs = (runs + MULTIWAY_FANIN - 1) / MULTIWAY_FANIN) passes++;
+    bool inBuffer = passes % 2 == 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) if (segments > 1)
+#endif
+    for (long long t = 0; t < tiles; t++) {
+        long long begin = t * tile, end = std::min(n, begin + tile);
+        mergeSortSerial(first + begin, first + end, buffer + begin, comp);
+        if (inBuffer) std::copy(first + begin, first + end, buffer + begin);
+    }
+
+    // Every pass merges groups of up to MULTIWAY_FANIN runs of length 'width'
+    for (long long width = tile; width < n; width *= MULTIWAY_FANIN) {
+        long long groupSize = width * MULTIWAY_FANIN;
+        for (long long group = 0; group < n; group += groupSize) {
+            long long groupEnd = std::min(n, group + groupSize);
+            if (inBuffer) {
+                std::vector<SortedRun<BufferIt> > runs;
+                for (long long r = group; r < groupEnd; r += width) {
+                    SortedRun<BufferIt> run = {buffer + r, buffer + std::min(groupEnd, r + width)};
+                    runs.push_back(run);
+                }
+                multiwayMerge(runs, first + group, comp, segments);
+            } else {
+                std::vector<SortedRun<RandomIt> > runs;
+                for (long long r = group; r < groupEnd; r += width) {
+                    SortedRun<RandomIt> run = {first + r, first + std::min(groupEnd, r + width)};
+                    runs.push_back(run);
+                }
+                multiwayMerge(runs, buffer + group, comp, segments);
+            }
+        }
+        inBuffer = !inBuffer;
+    }
+}
+
+} // namespace detail
+
+template <typename RandomIt, typename Compare>
+void multiwayMergeSortSerial(RandomIt first, RandomIt last, Compare comp) {
+    detail::Scratch<typename std::iterator_traits<RandomIt>::value_type> buffer(first, last);
+    detail::multiwayMergeSort(first, last, buffer.begin(), comp, 1);
+}
+
+#ifdef _OPENMP
+template <typename RandomIt, typename Compare>
+void multiwayMergeSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    detail::Scratch<typename std::iterator_traits<RandomIt>::value_type> buffer(first, last);
+    detail::multiwayMergeSort(first, last, buffer.begin(), comp, omp_in_parallel() ? 1 : omp_get_max_threads());
+}
+#else
+// Without OpenMP the parallel engine falls back to the serial one.
+template <typename RandomIt, typename Compare>
+void multiwayMergeSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    multiwayMergeSortSerial(first, last, comp);
+}
+#endif
+
+template <typename RandomIt>
+void multiwayMergeSortSerial(RandomIt first, RandomIt last) {
+    multiwayMergeSortSerial(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+template <typename RandomIt>
+void multiwayMergeSortParallel(RandomIt first, RandomIt last) {
+    multiwayMergeSortParallel(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+} // namespace sortlib
+
+#endif
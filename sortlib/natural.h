@@ -0,0 +1,292 @@
+#ifndef SORTLIB_NATURAL_H
+#define SORTLIB_NATURAL_H
+
+#include "detail.h"
+#include <vector>
+
+// Adaptive natural merge sort (powersort merge policy), stable.
+//
+// 1. Each chunk is scanned for runs: ascending (!(a[i + 1] < a[i])) or
+//    strictly descending. Interior descending runs are reversed and short
+//    runs are extended to NATURAL_MIN_RUN with insertion sort. Runs touching
+//    a chunk edge may continue in the next chunk, so descending edge runs
+//    are left alone until the chunks have been stitched.
+// 2. Runs that continue across chunk boundaries are joined (O(chunks)),
+//    then the remaining descending runs are reversed.
+// 3. Runs are merged along the powersort merge tree; in the parallel engine
+//    independent subtrees are merged as tasks and large merges are
+//    themselves split into tasks.
+// Sorted input is a single run after step 2 and finishes in one linear pass.
+
+namespace sortlib {
+
+namespace detail {
+
+// Shorter runs are extended to this length with insertion sort
+const int NATURAL_MIN_RUN = 32;
+
+struct NaturalRun {
+    long long start, end; // [start, end)
+    bool descending;
+};
+
+// Inserts [sorted, end) into the sorted prefix [start, sorted).
+template <typename RandomIt, typename Compare>
+void binaryInsertionSort(RandomIt first, long long start, long long sorted, long long end, Compare comp) {
+    for (long long i = sorted; i < end; i++) {
+        typename std::iterator_traits<RandomIt>::value_type key = std::move(first[i]);
+        RandomIt pos = std::upper_bound(first + start, first + i, key, comp);
+        std::move_backward(pos, first + i, first + i + 1);
+        *pos = std::move(key);
+    }
+}
+
+// Finds the natural run starting at 'start' (ending no later than 'limit').
+template <typename RandomIt, typename Compare>
+NaturalRun findRun(RandomIt first, long long start, long long limit, Compare comp) {
+    long long end = start + 1;
+    bool descending = end < limit && comp(first[end], first[start]);
+    if (descending) {
+        while (end < limit && comp(first[end], first[end - 1])) end++;
+    } else {
+        while (end < limit && !comp(first[end], first[end - 1])) end++;
+    }
+    NaturalRun run = {start, end, descending};
+    return run;
+}
+
+template <typename RandomIt, typename Compare>
+void detectRuns(RandomIt first, long long lo, long long hi, Compare comp, std::vector<NaturalRun> &runs) {
+    for (long long start = lo; start < hi;) {
+        NaturalRun run = findRun(first, start, hi, comp);
+        bool touchesEdge = run.start == lo || run.end == hi;
+        if (!(run.descending && touchesEdge)) {
+            if (run.descending) {
+                std::reverse(first + run.start, first + run.end);
+                run.descending = false;
+            }
+            if (run.end - run.start < NATURAL_MIN_RUN && run.end < hi) {
+                long long extended = std::min(hi, run.start + NATURAL_MIN_RUN);
+                binaryInsertionSort(first, run.start, run.end, extended, comp);
+                run.end = extended;
+            }
+        }
+        runs.push_back(run);
+        start = run.end;
+    }
+}
+
+// Powersort node power of the boundary between runs [s1, s1 + n1) and
+// [s1 + n1, s1 + n1 + n2): the first bit where the run midpoints, as
+// fractions of n, differ.
+inline int nodePower(long long s1, long long n1, long long n2, long long n) {
+    long long a = 2 * s1 + n1;
+    long long b = a + n1 + n2;
+    const long long twoN = 2 * n;
+    int power = 0;
+    while (true) {
+        power++;
+        a *= 2;
+        b *= 2;
+        bool da = a >= twoN, db = b >= twoN;
+        if (da != db) return power;
+        if (da) {
+            a -= twoN;
+            b -= twoN;
+        }
+    }
+}
+
+// Moves the merge of sorted buffer ranges [a, aEnd) and [b, bEnd) to out.
+// With 'tasks', large merges are split at matching ranks into independent
+// tasks; ties take the a side first either way.
+template <typename T, typename RandomIt, typename Compare>
+void naturalMerge(T *a, T *aEnd, T *b, T *bEnd, RandomIt out, Compare comp, bool tasks) {
+#ifdef _OPENMP
+    long long n1 = aEnd - a, n2 = bEnd - b;
+    if (tasks && n1 + n2 > TASK_THRESHOLD) {
+        T *aCut, *bCut;
+        if (n1 >= n2) {
+            aCut = a + n1 / 2;
+            bCut = std::lower_bound(b, bEnd, *aCut, comp);
+        } else {
+            bCut = b + n2 / 2;
+            aCut = std::upper_bound(a, aEnd, *bCut, comp);
+        }
+        RandomIt outCut = out + (aCut - a) + (bCut - b);
+#pragma omp task
+        naturalMerge(a, aCut, b, bCut, out, comp, tasks);
+#pragma omp task
+        naturalMerge(aCut, aEnd, bCut, bEnd, outCut, comp, tasks);
+#pragma omp taskwait
+        return;
+    }
+#endif
+    std::merge(std::make_move_iterator(a), std::make_move_iterator(aEnd),
+               std::make_move_iterator(b), std::make_move_iterator(bEnd), out, comp);
+}
+
+template <typename RandomIt, typename T, typename Compare>
+void mergeAdjacent(RandomIt first, T *buffer, long long start, long long mid, long long end, Compare comp,
+                   bool tasks) {
+    if (!comp(first[mid], first[mid - 1])) {
+        return;
+    }
+    if (comp(first[end - 1], first[start])) {
+        // Whole right run belongs before the left run
+        std::rotate(first + start, first + mid, first + end);
+        return;
+    }
+    // Elements already in their final place at either end do not take part
+    start = std::upper_bound(first + start, first + mid, first[mid], comp) - first;
+    end = std::lower_bound(first + mid, first + end, first[mid - 1], comp) - first;
+    std::move(first + start, first + end, buffer + start);
+    naturalMerge(buffer + start, buffer + mid, buffer + mid, buffer + end, first + start, comp, tasks);
+}
+
+// Merges runs [firstRun, lastRun] whose merge-tree root is boundary 'node'.
+template <typename RandomIt, typename T, typename Compare>
+void mergeTree(RandomIt first, T *buffer, Compare comp, bool tasks, const std::vector<NaturalRun> &runs,
+               const std::vector<int> &leftChild, const std::vector<int> &rightChild,
+               int node, int firstRun, int lastRun) {
+    long long start = runs[firstRun].start, mid = runs[node].end, end = runs[lastRun].end;
+#ifdef _OPENMP
+    if (tasks && end - start > TASK_THRESHOLD) {
+#pragma omp task shared(runs, leftChild, rightChild)
+        if (leftChild[node] >= 0)
+            mergeTree(first, buffer, comp, tasks, runs, leftChild, rightChild, leftChild[node], firstRun, node);
+#pragma omp task shared(runs, leftChild, rightChild)
+        if (rightChild[node] >= 0)
+            mergeTree(first, buffer, comp, tasks, runs, leftChild, rightChild, rightChild[node], node + 1, lastRun);
+#pragma omp taskwait
+        mergeAdjacent(first, buffer, start, mid, end, comp, tasks);
+        return;
+    }
+#endif
+    if (leftChild[node] >= 0)
+        mergeTree(first, buffer, comp, tasks, runs, leftChild, rightChild, leftChild[node], firstRun, node);
+    if (rightChild[node] >= 0)
+        mergeTree(first, buffer, comp, tasks, runs, leftChild, rightChild, rightChild[node], node + 1, lastRun);
+    mergeAdjacent(first, buffer, start, mid, end, comp, tasks);
+}
+
+// Run detection is split over 'chunks' chunks (in a parallel loop when there
+// is more than one); with 'tasks' the merge tree runs as OpenMP tasks.
+template <typename RandomIt, typename Compare>
+void naturalMergeSort(RandomIt first, RandomIt last, Compare comp, int chunks, bool tasks) {
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    long long size = last - first;
+    if (size < 2) {
+        return;
+    }
+
+    // Steps 1 and 2: run detection per chunk, then stitching at chunk edges
+    std::vector<std::vector<NaturalRun> > chunkRuns(chunks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1) if (chunks > 1)
+#endif
+    for (int t = 0; t < chunks; t++) {
+        detectRuns(first, size * t / chunks, size * (t + 1) / chunks, comp, chunkRuns[t]);
+    }
+
+    std::vector<NaturalRun> runs;
+    for (int t = 0; t < chunks; t++) {
+        for (size_t r = 0; r < chunkRuns[t].size(); r++) {
+            const NaturalRun &run = chunkRuns[t][r];
+            if (r == 0 && !runs.empty()) {
+                NaturalRun &previous = runs.back();
+                bool ascendingJoin = !previous.descending && !run.descending &&
+                                     !comp(first[run.start], first[previous.end - 1]);
+                bool descendingJoin = previous.descending && run.descending &&
+                                      comp(first[run.start], first[previous.end - 1]);
+                if (ascendingJoin || descendingJoin) {
+                    previous.end = run.end;
+                    continue;
+                }
+            }
+            runs.push_back(run);
+        }
+    }
+    for (size_t r = 0; r < runs.size(); r++) {
+        if (runs[r].descending) {
+            long long start = runs[r].start, end = runs[r].end, half = (end - start) / 2;
+#ifdef _OPENMP
+#pragma omp parallel for if (chunks > 1)
+#endif
+            for (long long i = 0; i < half; i++) {
+                std::swap(first[start + i], first[end - 1 - i]);
+            }
+        }
+    }
+
+    int numRuns = static_cast<int>(runs.size());
+    if (numRuns == 1) {
+        return;
+    }
+
+    // Step 3: powersort merge tree. Boundary i sits between runs i and i + 1;
+    // lower power means merged later. Built as a Cartesian tree with a stack.
+    std::vector<int> leftChild(numRuns - 1, -1), rightChild(numRuns - 1, -1), stack;
+    std::vector<int> power(numRuns - 1);
+    for (int i = 0; i < numRuns - 1; i++) {
+        power[i] = nodePower(runs[i].start, runs[i].end - runs[i].start,
+                             runs[i + 1].end - runs[i + 1].start, size);
+        int previous = -1;
+        while (!stack.empty() && power[stack.back()] > power[i]) {
+            previous = stack.back();
+            stack.pop_back();
+        }
+        leftChild[i] = previous;
+        if (!stack.empty()) rightChild[stack.back()] = i;
+        stack.push_back(i);
+    }
+
+    Scratch<T> buffer(first, last);
+#ifdef _OPENMP
+    if (tasks && !omp_in_parallel()) {
+#pragma omp parallel
+        {
+#pragma omp single
+            mergeTree(first, buffer.begin(), comp, tasks, runs, leftChild, rightChild, stack.front(), 0, numRuns - 1);
+        }
+        return;
+    }
+#endif
+    mergeTree(first, buffer.begin(), comp, tasks, runs, leftChild, rightChild, stack.front(), 0, numRuns - 1);
+}
+
+} // namespace detail
+
+template <typename RandomIt, typename Compare>
+void naturalMergeSortSerial(RandomIt first, RandomIt last, Compare comp) {
+    detail::naturalMergeSort(first, last, comp, 1, false);
+}
+
+#ifdef _OPENMP
+// Inside an enclosing parallel region run detection stays on the calling
+// thread and the merge tree runs as tasks of the enclosing team.
+template <typename RandomIt, typename Compare>
+void naturalMergeSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    detail::naturalMergeSort(first, last, comp, omp_in_parallel() ? 1 : omp_get_max_threads(), true);
+}
+#else
+// Without OpenMP the parallel engine falls back to the serial one.
+template <typename RandomIt, typename Compare>
+void naturalMergeSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    naturalMergeSortSerial(first, last, comp);
+}
+#endif
+
+template <typename RandomIt>
+void naturalMergeSortSerial(RandomIt first, RandomIt last) {
+    naturalMergeSortSerial(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+template <typename RandomIt>
+void naturalMergeSortParallel(RandomIt first, RandomIt last) {
+    naturalMergeSortParallel(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+} // namespace sortlib
+
+#endif
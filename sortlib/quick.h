@@ -0,0 +1,133 @@
+#ifndef SORTLIB_QUICK_H
+#define SORTLIB_QUICK_H
+
+#include "detail.h"
+
+// Quick sort with median-of-three pivot selection and three-way
+// partitioning: keys equal to the pivot are gathered in the middle and
+// never recursed into, so inputs with few distinct keys sort in O(n log k).
+// Recursion deeper than 2 log2(n) (an adversarial pivot sequence) finishes
+// the range with heap sort, so the worst case is O(n log n).
+
+namespace sortlib {
+
+namespace detail {
+
+// Partitions [first, last) around the median of the first, middle and last
+// elements into [first, lower) < pivot, [lower, upper) == pivot and
+// [upper, last) > pivot.
+template <typename RandomIt, typename Compare>
+std::pair<RandomIt, RandomIt> quickPartition(RandomIt first, RandomIt last, Compare comp) {
+    RandomIt high = last - 1;
+    RandomIt mid = first + (last - first) / 2;
+    if (comp(*mid, *first)) std::iter_swap(mid, first);
+    if (comp(*high, *first)) std::iter_swap(high, first);
+    if (comp(*high, *mid)) std::iter_swap(high, mid);
+    const typename std::iterator_traits<RandomIt>::value_type pivot = *mid;
+
+    RandomIt lower = first, i = first, upper = last;
+    while (i != upper) {
+        if (comp(*i, pivot)) {
+            std::iter_swap(lower++, i++);
+        } else if (comp(pivot, *i)) {
+            std::iter_swap(i, --upper);
+        } else {
+            ++i;
+        }
+    }
+    return std::make_pair(lower, upper);
+}
+
+// Recursion depth after which a range is heap sorted instead.
+template <typename Size>
+int quickDepthLimit(Size size) {
+    int depth = 0;
+    for (; size > 1; size /= 2) depth += 2;
+    return depth;
+}
+
+template <typename RandomIt, typename Compare>
+void quickSortSerial(RandomIt first, RandomIt last, Compare comp, int depth) {
+    while (last - first > LEAF_THRESHOLD) {
+        if (depth-- == 0) {
+            std::make_heap(first, last, comp);
+            std::sort_heap(first, last, comp);
+            return;
+        }
+        std::pair<RandomIt, RandomIt> equal = quickPartition(first, last, comp);
+        // Recurse into the smaller side, loop on the larger one
+        if (equal.first - first < last - equal.second) {
+            quickSortSerial(first, equal.first, comp, depth);
+            first = equal.second;
+        } else {
+            quickSortSerial(equal.second, last, comp, depth);
+            last = equal.first;
+        }
+    }
+    insertionSort(first, last, comp);
+}
+
+} // namespace detail
+
+template <typename RandomIt, typename Compare>
+void quickSortSerial(RandomIt first, RandomIt last, Compare comp) {
+    detail::quickSortSerial(first, last, comp, detail::quickDepthLimit(last - first));
+}
+
+#ifdef _OPENMP
+namespace detail {
+
+// Both sides become tasks until the depth limit, past which the range is
+// handed to the serial engine (which bounds its own stack and time).
+template <typename RandomIt, typename Compare>
+void quickSortTasks(RandomIt first, RandomIt last, Compare comp, int depth) {
+    if (last - first <= TASK_THRESHOLD || depth == 0) {
+        quickSortSerial(first, last, comp, depth);
+        return;
+    }
+    std::pair<RandomIt, RandomIt> equal = quickPartition(first, last, comp);
+#pragma omp task
+    quickSortTasks(first, equal.first, comp, depth - 1);
+#pragma omp task
+    quickSortTasks(equal.second, last, comp, depth - 1);
+#pragma omp taskwait
+}
+
+} // namespace detail
+
+// Task parallelism over the recursive calls, started from one thread of a
+// parallel region (or joining the caller's region if already inside one).
+template <typename RandomIt, typename Compare>
+void quickSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    int depth = detail::quickDepthLimit(last - first);
+    if (omp_in_parallel()) {
+        detail::quickSortTasks(first, last, comp, depth);
+        return;
+    }
+#pragma omp parallel
+    {
+#pragma omp single nowait
+        detail::quickSortTasks(first, last, comp, depth);
+    }
+}
+#else
+// Without OpenMP the parallel engine falls back to the serial one.
+template <typename RandomIt, typename Compare>
+void quickSortParallel(RandomIt first, RandomIt last, Compare comp) {
+    quickSortSerial(first, last, comp);
+}
+#endif
+
+template <typename RandomIt>
+void quickSortSerial(RandomIt first, RandomIt last) {
+    quickSortSerial(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+template <typename RandomIt>
+void quickSortParallel(RandomIt first, RandomIt last) {
+    quickSortParallel(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+} // namespace sortlib
+
+#endif
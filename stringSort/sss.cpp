@@ -0,0 +1,99 @@
+#include "../common/common.h"
+#include "strsort.h"
+#include <string>
+
+int main(int argc, char **argv) {
+    int size = 0, seed = 0;
+    std::string path;
+    StringAlgorithm algorithm = MULTIKEY_QUICKSORT;
+    bool wantLcp = false;
+    int next;
+
+    if (argc >= 3 && std::string(argv[1]) == "--file") {
+        // File mode: sort the lines of a newline-delimited file in place in the mapping
+        path = argv[2];
+        next = 3;
+    } else if (argc >= 3) {
+        // Command line mode
+        size = std::stoi(argv[1]);
+        seed = std::stoi(argv[2]);
+        next = 3;
+    } else {
+        // Interactive mode
+        std::cout << "Serial String Sort" << std::endl;
+        size = getUserInput();
+        std::cout << "Enter seed value for random number generation: ";
+        std::cin >> seed;
+        next = argc;
+    }
+    for (; next < argc; next++) {
+        std::string option = argv[next];
+        if (option == "radix") algorithm = MSD_RADIX;
+        else if (option == "mkqs") algorithm = MULTIKEY_QUICKSORT;
+        else if (option == "lcp") wantLcp = true;
+        else {
+            std::cerr << "Unknown option '" << option << "' (expected mkqs, radix or lcp)." << std::endl;
+            return -1;
+        }
+    }
+
+    // Validation
+    if (path.empty() && size < 1) {
+        std::cerr << "Size must be at least 1 element." << std::endl;
+        return -1;
+    }
+    if (path.empty() && size > MAX_ELEMENTS) {
+        std::cerr << "Size cannot exceed " << MAX_ELEMENTS << " elements." << std::endl;
+        return -1;
+    }
+
+    size_t length;
+    const char *data;
+    char *generated = nullptr;
+    if (path.empty()) {
+        generated = randStringData(size, seed, length);
+        data = generated;
+    } else {
+        data = mapFile(path.c_str(), length);
+        if (data == nullptr) return -1;
+    }
+
+    int count;
+    StringRef *strings = splitLines(data, length, count);
+    const char *name = algorithm == MSD_RADIX ? "MSD radix sort" : "multikey quicksort";
+
+    std::cout << "\nSorting " << count << " strings (" << name << ")..." << std::endl;
+    printStrings(strings, count, "Input Strings");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    stringSortSerial(strings, count, algorithm);
+    int *lcp = nullptr;
+    if (wantLcp) {
+        lcp = new int[count];
+        computeLcp(strings, count, lcp);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    printStrings(strings, count, "Sorted Strings");
+    if (wantLcp) {
+        long long total = 0;
+        for (int i = 0; i < count; i++) total += lcp[i];
+        std::cout << "Average LCP: " << (count > 1 ? static_cast<double>(total) / (count - 1) : 0.0)
+                  << " bytes" << std::endl;
+    }
+
+    std::chrono::duration<double> duration = end - start;
+    std::cout << "Serial String Sort Time: " << duration.count() << " seconds" << std::endl;
+
+    if (isSortedStrings(strings, count)) {
+        std::cout << "Successfully sorted!" << std::endl;
+    } else {
+        std::cout << "Sorting failed!" << std::endl;
+    }
+
+    delete[] lcp;
+    delete[] strings;
+    delete[] generated;
+    if (!path.empty()) unmapFile(data, length);
+    return 0;
+}
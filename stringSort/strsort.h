@@ -0,0 +1,362 @@
+#ifndef STRSORT_H
+#define STRSORT_H
+
+#include "../common/common.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// String sorting over views into one (usually memory-mapped) buffer; the
+// string bytes are never copied, only the 24-byte StringRef records move.
+//
+// Each StringRef caches 8 key bytes inline, big-endian and zero-padded, so
+// most comparisons are a single integer compare instead of a pointer chase.
+// The cache always holds the window [window, window + 8) where window is the
+// current depth rounded down to a multiple of 8; it is refreshed once per
+// string every 8 levels. Keys are assumed not to contain NUL bytes, which
+// lets a zero byte in the cache mean "string ended".
+
+struct StringRef {
+    const char *ptr;
+    int length;
+    uint64_t cache;
+};
+
+const int STRING_INSERTION_THRESHOLD = 16;
+const int STRING_RADIX_THRESHOLD = 64;
+const int STRING_TASK_THRESHOLD = 10000;
+
+inline void loadCache(StringRef &s, const int window) {
+    uint64_t cache = 0;
+    int available = s.length - window;
+    for (int i = 0; i < 8; i++) {
+        cache <<= 8;
+        if (i < available) {
+            cache |= static_cast<unsigned char>(s.ptr[window + i]);
+        }
+    }
+    s.cache = cache;
+}
+
+inline void loadCaches(StringRef *strings, const int n, const int window) {
+    for (int i = 0; i < n; i++) {
+        loadCache(strings[i], window);
+    }
+}
+
+// Full lexicographic comparison (unsigned bytes, shorter prefix first).
+inline int compareStrings(const StringRef &a, const StringRef &b) {
+    int c = std::memcmp(a.ptr, b.ptr, std::min(a.length, b.length));
+    if (c != 0) return c;
+    return (a.length > b.length) - (a.length < b.length);
+}
+
+// Compares two strings known to share their first 'window' bytes, using the
+// cache first and touching the string bytes only when the caches tie.
+inline bool stringLess(const StringRef &a, const StringRef &b, const int window) {
+    if (a.cache != b.cache) return a.cache < b.cache;
+    if ((a.cache & 0xFF) == 0) return false;
+    const int from = window + 8;
+    int c = std::memcmp(a.ptr + from, b.ptr + from, std::min(a.length, b.length) - from);
+    if (c != 0) return c < 0;
+    return a.length < b.length;
+}
+
+inline void insertionSortStrings(StringRef *strings, const int n, const int window) {
+    for (int i = 1; i < n; i++) {
+        StringRef key = strings[i];
+        int j = i - 1;
+        while (j >= 0 && stringLess(key, strings[j], window)) {
+            strings[j + 1] = strings[j];
+            j--;
+        }
+        strings[j + 1] = key;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Multikey (three-way radix) quicksort on 8-byte cached words
+// ---------------------------------------------------------------------------
+
+inline uint64_t medianOfThree(uint64_t a, uint64_t b, uint64_t c) {
+    if (a < b) return b < c ? b : (a < c ? c : a);
+    return a < c ? a : (b < c ? c : b);
+}
+
+// Three-way partition on the cached word: afterwards [0, lt) < pivot,
+// [lt, gt) == pivot and [gt, n) > pivot.
+inline void partitionStrings(StringRef *strings, const int n, int &lt, int &gt, uint64_t &pivot) {
+    pivot = medianOfThree(strings[0].cache, strings[n / 2].cache, strings[n - 1].cache);
+    lt = 0;
+    gt = n;
+    int i = 0;
+    while (i < gt) {
+        if (strings[i].cache < pivot) {
+            std::swap(strings[lt++], strings[i++]);
+        } else if (strings[i].cache > pivot) {
+            std::swap(strings[i], strings[--gt]);
+        } else {
+            i++;
+        }
+    }
+}
+
+inline void multikeyQuicksortSerial(StringRef *strings, int n, int window) {
+    while (n >= STRING_INSERTION_THRESHOLD) {
+        int lt, gt;
+        uint64_t pivot;
+        partitionStrings(strings, n, lt, gt, pivot);
+        multikeyQuicksortSerial(strings, lt, window);
+        multikeyQuicksortSerial(strings + gt, n - gt, window);
+        // The equal block only needs more work if its strings go on past this window
+        if ((pivot & 0xFF) == 0) {
+            return;
+        }
+        strings += lt;
+        n = gt - lt;
+        window += 8;
+        loadCaches(strings, n, window);
+    }
+    insertionSortStrings(strings, n, window);
+}
+
+// ---------------------------------------------------------------------------
+// MSD radix sort, one byte per level, read from the cached window
+// ---------------------------------------------------------------------------
+
+inline int cachedByte(const StringRef &s, const int depth) {
+    return static_cast<int>((s.cache >> (56 - 8 * (depth & 7))) & 0xFF);
+}
+
+// Distributes strings by their byte at 'depth' through 'buffer' and leaves
+// the bucket boundaries in bucketStart[0..256].
+inline void distributeStrings(StringRef *strings, StringRef *buffer, const int n, const int depth,
+                              int bucketStart[257]) {
+    int count[256] = {0};
+    for (int i = 0; i < n; i++) {
+        count[cachedByte(strings[i], depth)]++;
+    }
+    int offset = 0;
+    for (int b = 0; b < 256; b++) {
+        bucketStart[b] = offset;
+        offset += count[b];
+    }
+    bucketStart[256] = n;
+    int next[256];
+    std::copy(bucketStart, bucketStart + 256, next);
+    for (int i = 0; i < n; i++) {
+        buffer[next[cachedByte(strings[i], depth)]++] = strings[i];
+    }
+    std::copy(buffer, buffer + n, strings);
+}
+
+inline void msdRadixSortSerial(StringRef *strings, StringRef *buffer, const int n, const int depth) {
+    if (n < STRING_RADIX_THRESHOLD) {
+        // Strings here share their first 'depth' bytes, so the word-aligned
+        // window below depth still orders them correctly
+        multikeyQuicksortSerial(strings, n, depth & ~7);
+        return;
+    }
+    int bucketStart[257];
+    distributeStrings(strings, buffer, n, depth, bucketStart);
+    // Bucket 0 holds strings that ended before 'depth'; they are all equal
+    for (int b = 1; b < 256; b++) {
+        int size = bucketStart[b + 1] - bucketStart[b];
+        if (size > 1) {
+            StringRef *bucket = strings + bucketStart[b];
+            if (((depth + 1) & 7) == 0) {
+                loadCaches(bucket, size, depth + 1);
+            }
+            msdRadixSortSerial(bucket, buffer + bucketStart[b], size, depth + 1);
+        }
+    }
+}
+
+#ifdef _OPENMP
+// Task-parallel versions, in the style of quickSort_parallel: large
+// subproblems become tasks, small ones run the serial kernels.
+inline void multikeyQuicksortParallel(StringRef *strings, int n, int window) {
+    if (n < STRING_TASK_THRESHOLD) {
+        multikeyQuicksortSerial(strings, n, window);
+        return;
+    }
+    int lt, gt;
+    uint64_t pivot;
+    partitionStrings(strings, n, lt, gt, pivot);
+#pragma omp task
+    multikeyQuicksortParallel(strings, lt, window);
+#pragma omp task
+    multikeyQuicksortParallel(strings + gt, n - gt, window);
+    if ((pivot & 0xFF) != 0) {
+        loadCaches(strings + lt, gt - lt, window + 8);
+        multikeyQuicksortParallel(strings + lt, gt - lt, window + 8);
+    }
+#pragma omp taskwait
+}
+
+inline void msdRadixSortParallel(StringRef *strings, StringRef *buffer, const int n, const int depth) {
+    if (n < STRING_TASK_THRESHOLD) {
+        msdRadixSortSerial(strings, buffer, n, depth);
+        return;
+    }
+    int bucketStart[257];
+    distributeStrings(strings, buffer, n, depth, bucketStart);
+    for (int b = 1; b < 256; b++) {
+        int size = bucketStart[b + 1] - bucketStart[b];
+        if (size > 1) {
+            StringRef *bucket = strings + bucketStart[b];
+            StringRef *bucketBuffer = buffer + bucketStart[b];
+#pragma omp task firstprivate(bucket, bucketBuffer, size)
+            {
+                if (((depth + 1) & 7) == 0) {
+                    loadCaches(bucket, size, depth + 1);
+                }
+                msdRadixSortParallel(bucket, bucketBuffer, size, depth + 1);
+            }
+        }
+    }
+#pragma omp taskwait
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Entry points
+// ---------------------------------------------------------------------------
+
+enum StringAlgorithm { MULTIKEY_QUICKSORT, MSD_RADIX };
+
+inline void stringSortSerial(StringRef *strings, const int n, const StringAlgorithm algorithm) {
+    loadCaches(strings, n, 0);
+    if (algorithm == MSD_RADIX) {
+        StringRef *buffer = new StringRef[n];
+        msdRadixSortSerial(strings, buffer, n, 0);
+        delete[] buffer;
+    } else {
+        multikeyQuicksortSerial(strings, n, 0);
+    }
+}
+
+inline void stringSortParallel(StringRef *strings, const int n, const StringAlgorithm algorithm) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        loadCache(strings[i], 0);
+    }
+    StringRef *buffer = algorithm == MSD_RADIX ? new StringRef[n] : nullptr;
+#pragma omp parallel
+    {
+#pragma omp single nowait
+        {
+            if (algorithm == MSD_RADIX) {
+                msdRadixSortParallel(strings, buffer, n, 0);
+            } else {
+                multikeyQuicksortParallel(strings, n, 0);
+            }
+        }
+    }
+    delete[] buffer;
+#else
+    stringSortSerial(strings, n, algorithm);
+#endif
+}
+
+// lcp[i] = length of the longest common prefix of strings[i - 1] and
+// strings[i]; lcp[0] = 0.
+inline void computeLcp(const StringRef *strings, const int n, int *lcp) {
+    if (n > 0) lcp[0] = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 1; i < n; i++) {
+        const StringRef &a = strings[i - 1], &b = strings[i];
+        const int limit = std::min(a.length, b.length);
+        int k = 0;
+        while (k < limit && a.ptr[k] == b.ptr[k]) k++;
+        lcp[i] = k;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Input
+// ---------------------------------------------------------------------------
+
+// Splits a newline-delimited buffer into views (a trailing '\r' is dropped
+// from each line, and a missing final newline is tolerated).
+inline StringRef *splitLines(const char *data, const size_t length, int &count) {
+    const char *end = data + length;
+    count = 0;
+    for (const char *p = data; p < end; count++) {
+        const char *nl = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        p = nl ? nl + 1 : end;
+    }
+    StringRef *strings = new StringRef[count];
+    const char *p = data;
+    for (int i = 0; i < count; i++) {
+        const char *nl = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        const char *lineEnd = nl ? nl : end;
+        int len = static_cast<int>(lineEnd - p);
+        if (len > 0 && p[len - 1] == '\r') len--;
+        strings[i].ptr = p;
+        strings[i].length = len;
+        strings[i].cache = 0;
+        p = nl ? nl + 1 : end;
+    }
+    return strings;
+}
+
+// Generates 'count' newline-delimited URL-like keys. Hosts and path segments
+// come from small vocabularies so the keys share long prefixes, which is
+// what makes string sorting expensive.
+inline char *randStringData(const int count, const int seed, size_t &length) {
+    static const char *const segments[] = {"/api", "/users", "/products", "/orders", "/search",
+                                           "/static", "/images", "/v1", "/v2", "/account"};
+    srand(seed);
+    std::vector<char> text;
+    text.reserve(static_cast<size_t>(count) * 48);
+    char number[32];
+    for (int i = 0; i < count; i++) {
+        int written = snprintf(number, sizeof(number), "https://www.site%d.com", std::rand() % 64);
+        text.insert(text.end(), number, number + written);
+        int depth = 1 + std::rand() % 4;
+        for (int d = 0; d < depth; d++) {
+            const char *segment = segments[std::rand() % 10];
+            text.insert(text.end(), segment, segment + std::strlen(segment));
+        }
+        written = snprintf(number, sizeof(number), "/%d", (std::rand() % MAX_RANDOM_VALUE) + 1);
+        text.insert(text.end(), number, number + written);
+        text.push_back('\n');
+    }
+    length = text.size();
+    char *data = new char[length];
+    std::copy(text.begin(), text.end(), data);
+    return data;
+}
+
+inline bool isSortedStrings(const StringRef *strings, const int n) {
+    for (int i = 0; i < n - 1; i++) {
+        if (compareStrings(strings[i], strings[i + 1]) > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void printStrings(const StringRef *strings, const int n, const char *label) {
+    std::cout << label << " [" << n << " strings]:" << std::endl;
+    for (int i = 0; i < n; i++) {
+        if (n > 6 && i == 3) {
+            std::cout << "  ..." << std::endl;
+            i = n - 3;
+        }
+        std::cout << "  ";
+        std::cout.write(strings[i].ptr, strings[i].length);
+        std::cout << std::endl;
+    }
+}
+
+#endif